@@ -0,0 +1,125 @@
+// BigFont.h
+// Pre-rendered, run-length encoded large fonts used by TFT_LargeText()
+// GENERATED by tools/bigfontgen.py from Fonts.h - edit the generator or source font, not this file
+// Runs: bit 7 = foreground, bits 0-6 = length-1, columns right to left, each top to bottom
+
+// Scale 2 numerals and units, 24x32 cells (Scale2x)
+#define BIG_FONT_WIDTH		24
+#define BIG_FONT_HEIGHT	32
+
+const char BIG_FONT_CHARS[] PROGMEM = " 0123456789.-VAWkMCF%~<>";
+
+// Offset of each glyph's runs in BIG_FONT_RUNS, plus one past the end
+const unsigned short BIG_FONT_INDEX[25] PROGMEM = {
+	0,6,79,129,226,323,392,489,566,631,720,797,814,855,893,950,995,1052,1097,1166,1235,1294,1329,1391,1453
+};
+
+const unsigned char BIG_FONT_RUNS[1453] PROGMEM = {
+	0x7F,0x7F,0x7F,0x7F,0x7F,0x7F,0x46,0x91,0x0B,0x95,0x09,0x95,0x08,0x97,0x07,0x97,0x07,0x97,0x07,0x81,0x01,0x85,0x0A,0x82,
+	0x07,0x81,0x02,0x84,0x0B,0x81,0x07,0x81,0x02,0x87,0x08,0x81,0x07,0x81,0x04,0x87,0x06,0x81,0x07,0x81,0x06,0x87,0x04,0x81,
+	0x07,0x81,0x08,0x87,0x02,0x81,0x07,0x81,0x0B,0x84,0x02,0x81,0x07,0x82,0x0A,0x85,0x01,0x81,0x07,0x97,0x07,0x97,0x07,0x97,
+	0x08,0x95,0x09,0x95,0x0B,0x91,0x46,0x7F,0x19,0x81,0x1D,0x81,0x1D,0x81,0x1D,0x81,0x1D,0x81,0x1C,0x82,0x08,0x96,0x07,0x97,
+	0x07,0x97,0x08,0x96,0x0A,0x94,0x0C,0x92,0x0C,0x85,0x09,0x82,0x0D,0x83,0x0B,0x81,0x0D,0x83,0x0B,0x81,0x0D,0x83,0x0B,0x81,
+	0x0D,0x83,0x0B,0x81,0x0E,0x81,0x0C,0x81,0x43,0x48,0x81,0x0B,0x83,0x0B,0x85,0x08,0x85,0x0A,0x85,0x08,0x85,0x08,0x89,0x06,
+	0x85,0x08,0x89,0x06,0x85,0x07,0x8C,0x05,0x84,0x07,0x84,0x01,0x85,0x07,0x82,0x07,0x82,0x05,0x85,0x06,0x81,0x07,0x82,0x05,
+	0x85,0x06,0x81,0x07,0x81,0x08,0x85,0x04,0x81,0x07,0x81,0x08,0x85,0x04,0x81,0x07,0x81,0x0A,0x85,0x02,0x81,0x07,0x81,0x0A,
+	0x85,0x02,0x81,0x07,0x82,0x0B,0x84,0x01,0x81,0x07,0x84,0x09,0x88,0x07,0x85,0x0A,0x86,0x07,0x85,0x0A,0x86,0x08,0x84,0x0C,
+	0x84,0x08,0x84,0x0C,0x84,0x0A,0x81,0x0F,0x81,0x44,0x48,0x81,0x09,0x81,0x0F,0x85,0x05,0x85,0x0D,0x85,0x05,0x85,0x0B,0x88,
+	0x03,0x88,0x09,0x88,0x03,0x88,0x08,0x8A,0x01,0x8A,0x07,0x84,0x01,0x89,0x01,0x84,0x07,0x82,0x05,0x85,0x05,0x82,0x07,0x82,
+	0x05,0x85,0x05,0x82,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,
+	0x07,0x83,0x07,0x81,0x07,0x82,0x07,0x81,0x07,0x82,0x07,0x84,0x0D,0x84,0x07,0x85,0x0B,0x85,0x07,0x85,0x0B,0x85,0x08,0x84,
+	0x0B,0x84,0x09,0x84,0x0B,0x84,0x0B,0x81,0x0D,0x81,0x46,0x50,0x81,0x06,0x81,0x13,0x83,0x05,0x81,0x13,0x83,0x05,0x81,0x12,
+	0x85,0x03,0x82,0x08,0x96,0x07,0x97,0x07,0x97,0x07,0x97,0x07,0x97,0x08,0x96,0x08,0x84,0x04,0x85,0x03,0x82,0x0A,0x82,0x05,
+	0x83,0x05,0x81,0x0A,0x83,0x04,0x83,0x05,0x81,0x0C,0x83,0x02,0x83,0x05,0x81,0x0C,0x83,0x02,0x83,0x16,0x82,0x01,0x83,0x16,
+	0x88,0x18,0x86,0x18,0x86,0x1A,0x83,0x4C,0x43,0x81,0x0C,0x83,0x0C,0x81,0x0A,0x87,0x0A,0x81,0x0A,0x87,0x0A,0x81,0x08,0x8B,
+	0x08,0x81,0x08,0x8B,0x08,0x81,0x07,0x8D,0x07,0x81,0x07,0x86,0x01,0x84,0x07,0x81,0x07,0x84,0x05,0x82,0x07,0x81,0x07,0x84,
+	0x05,0x82,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,
+	0x07,0x81,0x07,0x82,0x05,0x84,0x06,0x82,0x07,0x8D,0x04,0x84,0x07,0x8D,0x03,0x85,0x07,0x8D,0x03,0x85,0x07,0x8D,0x03,0x84,
+	0x08,0x8D,0x03,0x84,0x09,0x8B,0x05,0x81,0x46,0x50,0x87,0x15,0x8B,0x13,0x8B,0x12,0x8D,0x07,0x81,0x07,0x8D,0x07,0x81,0x07,
+	0x8D,0x07,0x81,0x07,0x84,0x05,0x82,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x82,0x06,0x83,0x07,
+	0x81,0x07,0x82,0x06,0x83,0x07,0x81,0x07,0x84,0x04,0x83,0x07,0x81,0x07,0x84,0x04,0x83,0x07,0x81,0x08,0x85,0x01,0x85,0x05,
+	0x82,0x08,0x96,0x0A,0x94,0x0A,0x94,0x0C,0x91,0x0D,0x91,0x0F,0x8D,0x46,0x04,0x87,0x16,0x8A,0x14,0x8A,0x14,0x8C,0x12,0x8C,
+	0x12,0x8E,0x10,0x82,0x05,0x85,0x10,0x81,0x08,0x85,0x0E,0x81,0x08,0x85,0x0E,0x81,0x0A,0x85,0x0C,0x81,0x0A,0x89,0x08,0x81,
+	0x0C,0x88,0x07,0x81,0x0C,0x88,0x07,0x81,0x0E,0x86,0x07,0x81,0x0E,0x86,0x07,0x82,0x0F,0x83,0x08,0x86,0x18,0x87,0x17,0x87,
+	0x17,0x87,0x17,0x87,0x18,0x85,0x54,0x46,0x85,0x05,0x85,0x0B,0x88,0x03,0x88,0x09,0x88,0x03,0x88,0x08,0x8A,0x01,0x8A,0x07,
+	0x97,0x07,0x97,0x07,0x82,0x05,0x87,0x03,0x82,0x07,0x81,0x07,0x85,0x05,0x81,0x07,0x81,0x07,0x85,0x05,0x81,0x07,0x81,0x06,
+	0x85,0x06,0x81,0x07,0x81,0x06,0x85,0x06,0x81,0x07,0x81,0x05,0x85,0x07,0x81,0x07,0x81,0x05,0x85,0x07,0x81,0x07,0x82,0x03,
+	0x87,0x05,0x82,0x07,0x97,0x07,0x97,0x07,0x8A,0x01,0x8A,0x08,0x88,0x03,0x88,0x09,0x88,0x03,0x88,0x0B,0x85,0x05,0x85,0x46,
+	0x46,0x8D,0x0F,0x91,0x0D,0x91,0x0C,0x94,0x0A,0x94,0x0A,0x96,0x08,0x82,0x05,0x85,0x01,0x85,0x08,0x81,0x07,0x83,0x04,0x84,
+	0x07,0x81,0x07,0x83,0x04,0x84,0x07,0x81,0x07,0x83,0x06,0x82,0x07,0x81,0x07,0x83,0x06,0x82,0x07,0x81,0x07,0x83,0x07,0x81,
+	0x07,0x81,0x07,0x83,0x07,0x81,0x07,0x82,0x05,0x84,0x07,0x81,0x07,0x8D,0x07,0x81,0x07,0x8D,0x07,0x81,0x07,0x8D,0x12,0x8B,
+	0x13,0x8B,0x15,0x87,0x50,0x7F,0x7F,0x7F,0x16,0x83,0x1A,0x85,0x19,0x85,0x19,0x85,0x19,0x85,0x1A,0x83,0x7F,0x44,0x4E,0x81,
+	0x1C,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,
+	0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1B,0x83,0x1C,0x81,0x4E,0x7F,0x04,0x8F,0x0E,0x92,0x0C,0x92,0x0C,0x94,
+	0x0A,0x94,0x0B,0x95,0x19,0x85,0x1B,0x84,0x1B,0x83,0x1B,0x83,0x1A,0x84,0x18,0x85,0x09,0x95,0x08,0x94,0x0A,0x94,0x0A,0x92,
+	0x0C,0x92,0x0D,0x8F,0x4A,0x4A,0x8F,0x0D,0x92,0x0C,0x92,0x0A,0x94,0x0A,0x94,0x08,0x95,0x09,0x85,0x05,0x83,0x0E,0x84,0x08,
+	0x81,0x0F,0x84,0x08,0x81,0x0F,0x83,0x09,0x81,0x0F,0x83,0x09,0x81,0x0F,0x84,0x08,0x81,0x0F,0x84,0x08,0x81,0x10,0x85,0x05,
+	0x83,0x0F,0x95,0x0B,0x94,0x0A,0x94,0x0C,0x92,0x0C,0x92,0x0E,0x8F,0x44,0x04,0x8D,0x10,0x90,0x0E,0x92,0x0C,0x94,0x0A,0x96,
+	0x09,0x96,0x16,0x88,0x17,0x87,0x17,0x87,0x16,0x87,0x12,0x89,0x15,0x89,0x1A,0x87,0x18,0x87,0x17,0x87,0x16,0x88,0x08,0x96,
+	0x07,0x96,0x08,0x94,0x0A,0x92,0x0C,0x90,0x0F,0x8D,0x4C,0x4B,0x81,0x0A,0x81,0x10,0x82,0x07,0x84,0x0F,0x82,0x07,0x84,0x0F,
+	0x84,0x03,0x86,0x0F,0x84,0x03,0x86,0x10,0x84,0x01,0x86,0x11,0x8B,0x15,0x87,0x17,0x87,0x19,0x83,0x1C,0x81,0x1D,0x81,0x10,
+	0x95,0x08,0x97,0x07,0x97,0x07,0x97,0x07,0x97,0x07,0x97,0x07,0x82,0x11,0x82,0x07,0x81,0x13,0x81,0x43,0x04,0x95,0x08,0x97,
+	0x07,0x97,0x07,0x97,0x07,0x97,0x08,0x95,0x09,0x88,0x18,0x86,0x18,0x87,0x19,0x87,0x18,0x87,0x17,0x87,0x16,0x87,0x15,0x87,
+	0x17,0x86,0x16,0x88,0x16,0x95,0x08,0x97,0x07,0x97,0x07,0x97,0x07,0x97,0x08,0x95,0x44,0x46,0x81,0x0D,0x81,0x0B,0x84,0x0B,
+	0x84,0x09,0x84,0x0B,0x84,0x08,0x85,0x0B,0x85,0x07,0x85,0x0B,0x85,0x07,0x84,0x0D,0x84,0x07,0x82,0x11,0x82,0x07,0x81,0x13,
+	0x81,0x07,0x81,0x13,0x81,0x07,0x81,0x13,0x81,0x07,0x81,0x13,0x81,0x07,0x82,0x11,0x82,0x07,0x82,0x11,0x82,0x07,0x84,0x0D,
+	0x84,0x07,0x97,0x08,0x95,0x09,0x95,0x0B,0x91,0x0D,0x91,0x0F,0x8D,0x48,0x44,0x84,0x19,0x85,0x19,0x84,0x03,0x85,0x10,0x82,
+	0x04,0x87,0x0F,0x82,0x04,0x87,0x0F,0x81,0x06,0x85,0x10,0x81,0x06,0x85,0x10,0x81,0x07,0x83,0x11,0x81,0x07,0x83,0x11,0x81,
+	0x07,0x83,0x11,0x81,0x07,0x83,0x07,0x81,0x07,0x82,0x05,0x85,0x05,0x82,0x07,0x97,0x07,0x97,0x07,0x97,0x07,0x97,0x07,0x97,
+	0x07,0x97,0x07,0x82,0x11,0x82,0x07,0x81,0x13,0x81,0x43,0x7F,0x05,0x84,0x09,0x83,0x0C,0x86,0x06,0x85,0x0C,0x85,0x06,0x85,
+	0x0E,0x85,0x04,0x85,0x0E,0x85,0x04,0x85,0x10,0x85,0x03,0x83,0x11,0x85,0x1B,0x85,0x19,0x85,0x1B,0x85,0x11,0x83,0x03,0x85,
+	0x10,0x85,0x04,0x85,0x0E,0x85,0x04,0x85,0x0E,0x85,0x06,0x85,0x0C,0x85,0x06,0x86,0x0C,0x83,0x09,0x84,0x7F,0x05,0x7F,0x46,
+	0x83,0x19,0x87,0x17,0x87,0x16,0x89,0x15,0x82,0x03,0x82,0x15,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x15,0x82,0x03,0x82,0x15,
+	0x89,0x16,0x87,0x17,0x87,0x19,0x83,0x7F,0x54,0x7F,0x01,0x81,0x17,0x81,0x03,0x82,0x15,0x82,0x03,0x82,0x15,0x82,0x03,0x84,
+	0x11,0x84,0x03,0x84,0x11,0x84,0x04,0x85,0x0D,0x85,0x05,0x85,0x0D,0x85,0x07,0x85,0x09,0x85,0x09,0x85,0x09,0x85,0x0B,0x85,
+	0x05,0x85,0x0D,0x85,0x05,0x85,0x0F,0x85,0x01,0x85,0x11,0x8D,0x13,0x89,0x15,0x89,0x17,0x85,0x19,0x85,0x1B,0x81,0x4E,0x7F,
+	0x0E,0x81,0x1B,0x85,0x19,0x85,0x17,0x89,0x15,0x89,0x13,0x8D,0x11,0x85,0x01,0x85,0x0F,0x85,0x05,0x85,0x0D,0x85,0x05,0x85,
+	0x0B,0x85,0x09,0x85,0x09,0x85,0x09,0x85,0x07,0x85,0x0D,0x85,0x05,0x85,0x0D,0x85,0x04,0x84,0x11,0x84,0x03,0x84,0x11,0x84,
+	0x03,0x82,0x15,0x82,0x03,0x82,0x15,0x82,0x03,0x81,0x17,0x81,0x41
+};
+
+// Scale 3 startup title, 36x48 cells (Scale3x)
+#define TITLE_FONT_WIDTH		36
+#define TITLE_FONT_HEIGHT	48
+
+const char TITLE_FONT_CHARS[] PROGMEM = "FZR250";
+
+// Offset of each glyph's runs in TITLE_FONT_RUNS, plus one past the end
+const unsigned short TITLE_FONT_INDEX[7] PROGMEM = {
+	0,105,252,345,492,639,750
+};
+
+const unsigned char TITLE_FONT_RUNS[750] PROGMEM = {
+	0x7F,0x17,0x86,0x27,0x87,0x26,0x88,0x26,0x86,0x06,0x87,0x19,0x85,0x06,0x89,0x18,0x84,0x06,0x8B,0x17,0x83,0x07,0x8B,0x17,
+	0x83,0x08,0x89,0x18,0x82,0x09,0x89,0x18,0x82,0x0A,0x87,0x19,0x82,0x0A,0x87,0x19,0x82,0x0B,0x85,0x1A,0x82,0x0B,0x85,0x1A,
+	0x82,0x0B,0x85,0x1A,0x82,0x0B,0x85,0x1A,0x82,0x0B,0x85,0x0B,0x82,0x0B,0x83,0x09,0x87,0x0A,0x82,0x0B,0x84,0x07,0x89,0x07,
+	0x84,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0x84,0x19,0x84,0x0B,
+	0x82,0x1D,0x82,0x0B,0x82,0x1D,0x82,0x7F,0x15,0x7F,0x17,0x84,0x10,0x89,0x0E,0x87,0x0E,0x8A,0x0C,0x89,0x0D,0x8B,0x0B,0x8A,
+	0x0E,0x89,0x0B,0x8B,0x0E,0x88,0x0B,0x8C,0x0E,0x87,0x0B,0x8D,0x0E,0x86,0x0B,0x8E,0x0E,0x85,0x0B,0x8F,0x0E,0x84,0x0B,0x84,
+	0x01,0x89,0x0E,0x83,0x0B,0x83,0x04,0x88,0x0D,0x83,0x0B,0x82,0x06,0x88,0x0D,0x82,0x0B,0x82,0x07,0x88,0x0C,0x82,0x0B,0x82,
+	0x08,0x88,0x0B,0x82,0x0B,0x82,0x09,0x88,0x0A,0x82,0x0B,0x82,0x0A,0x88,0x09,0x82,0x0B,0x82,0x0B,0x88,0x08,0x82,0x0B,0x82,
+	0x0C,0x88,0x07,0x82,0x0B,0x82,0x0D,0x88,0x06,0x82,0x0B,0x83,0x0D,0x88,0x04,0x83,0x0B,0x83,0x0E,0x89,0x01,0x84,0x0B,0x84,
+	0x0E,0x8F,0x0B,0x85,0x0E,0x8E,0x0B,0x86,0x0E,0x8D,0x0B,0x87,0x0E,0x8C,0x0B,0x88,0x0E,0x8B,0x0B,0x89,0x0E,0x8A,0x0B,0x8B,
+	0x0D,0x89,0x0C,0x8A,0x0E,0x87,0x0E,0x89,0x10,0x84,0x7F,0x17,0x7F,0x1A,0x87,0x0C,0x87,0x10,0x8B,0x08,0x8A,0x0E,0x8E,0x04,
+	0x8D,0x0C,0xA2,0x0C,0xA2,0x0B,0xA3,0x0B,0xA3,0x0B,0xA2,0x0C,0xA1,0x0D,0x84,0x07,0x8C,0x15,0x83,0x09,0x89,0x17,0x82,0x0B,
+	0x87,0x18,0x82,0x0B,0x86,0x19,0x82,0x0B,0x86,0x19,0x82,0x0B,0x85,0x1A,0x82,0x0B,0x85,0x1A,0x83,0x09,0x87,0x19,0x84,0x07,
+	0x89,0x18,0xA1,0x0D,0xA2,0x0C,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0x84,0x19,0x84,0x0B,
+	0x82,0x1D,0x82,0x0B,0x82,0x1D,0x82,0x7F,0x15,0x7F,0x1D,0x81,0x12,0x84,0x13,0x85,0x0F,0x86,0x11,0x87,0x0D,0x88,0x0F,0x89,
+	0x0C,0x88,0x0E,0x8B,0x0B,0x88,0x0D,0x8D,0x0A,0x88,0x0C,0x8F,0x09,0x88,0x0C,0x90,0x09,0x87,0x0B,0x92,0x09,0x86,0x0B,0x87,
+	0x01,0x89,0x0A,0x84,0x0B,0x85,0x05,0x88,0x0A,0x83,0x0B,0x84,0x07,0x88,0x0A,0x82,0x0B,0x83,0x09,0x88,0x09,0x82,0x0B,0x83,
+	0x0A,0x88,0x08,0x82,0x0B,0x82,0x0C,0x88,0x07,0x82,0x0B,0x82,0x0D,0x88,0x06,0x82,0x0B,0x82,0x0E,0x88,0x05,0x82,0x0B,0x82,
+	0x0F,0x88,0x04,0x82,0x0B,0x82,0x10,0x88,0x03,0x82,0x0B,0x83,0x10,0x88,0x02,0x82,0x0B,0x84,0x10,0x87,0x02,0x82,0x0B,0x86,
+	0x0F,0x8C,0x0B,0x87,0x0F,0x8B,0x0B,0x88,0x0F,0x8A,0x0B,0x88,0x10,0x89,0x0C,0x87,0x11,0x88,0x0C,0x87,0x12,0x87,0x0D,0x86,
+	0x13,0x86,0x0E,0x84,0x15,0x84,0x11,0x81,0x18,0x81,0x7F,0x17,0x7F,0x15,0x82,0x13,0x84,0x13,0x82,0x11,0x88,0x11,0x82,0x10,
+	0x8A,0x10,0x82,0x0F,0x8C,0x0F,0x82,0x0E,0x8E,0x0E,0x82,0x0D,0x90,0x0D,0x82,0x0C,0x92,0x0C,0x82,0x0C,0x92,0x0C,0x82,0x0B,
+	0x94,0x0B,0x82,0x0B,0x8A,0x01,0x87,0x0B,0x82,0x0B,0x88,0x05,0x85,0x0B,0x82,0x0B,0x87,0x07,0x84,0x0B,0x82,0x0B,0x86,0x09,
+	0x83,0x0B,0x82,0x0B,0x86,0x09,0x83,0x0B,0x82,0x0B,0x85,0x0B,0x82,0x0B,0x82,0x0B,0x85,0x0B,0x82,0x0B,0x82,0x0B,0x85,0x0B,
+	0x82,0x0B,0x82,0x0B,0x85,0x0B,0x82,0x0B,0x82,0x0B,0x85,0x0B,0x82,0x0B,0x83,0x09,0x86,0x0A,0x83,0x0B,0x84,0x07,0x87,0x09,
+	0x84,0x0B,0x94,0x07,0x86,0x0B,0x94,0x06,0x87,0x0B,0x94,0x05,0x88,0x0B,0x94,0x05,0x88,0x0B,0x94,0x05,0x87,0x0C,0x94,0x05,
+	0x87,0x0C,0x94,0x05,0x86,0x0E,0x92,0x07,0x84,0x10,0x90,0x09,0x81,0x7F,0x1A,0x7F,0x1A,0x99,0x13,0x9D,0x10,0x9F,0x0E,0xA1,
+	0x0D,0xA1,0x0C,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0x82,0x02,0x88,0x0F,0x84,0x0B,0x82,0x02,0x88,0x10,0x83,0x0B,0x82,
+	0x03,0x87,0x11,0x82,0x0B,0x82,0x04,0x8A,0x0D,0x82,0x0B,0x82,0x05,0x8B,0x0B,0x82,0x0B,0x82,0x07,0x8B,0x09,0x82,0x0B,0x82,
+	0x09,0x8B,0x07,0x82,0x0B,0x82,0x0B,0x8B,0x05,0x82,0x0B,0x82,0x0D,0x8A,0x04,0x82,0x0B,0x82,0x11,0x87,0x03,0x82,0x0B,0x83,
+	0x10,0x88,0x02,0x82,0x0B,0x84,0x0F,0x88,0x02,0x82,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0B,0xA3,0x0C,0xA1,0x0D,0xA1,0x0E,0x9F,
+	0x10,0x9D,0x13,0x99,0x7F,0x1A
+};
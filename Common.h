@@ -10,6 +10,13 @@
 
 #define CAN_BASE_ID		30
 
+// Constant tables the Monitor only ever reads live in flash, the Core still keeps them in SRAM
+#ifdef MONITOR
+	#define MONITOR_PROGMEM	PROGMEM const
+#else
+	#define MONITOR_PROGMEM
+#endif
+
 #define PACK_CAPACITY_MULTIPLIER	5 // Ah steps in settings, also affects max capacity, normally 5
 #define PACK_VOLTAGE_MULTIPLIER		1 // 1 for normal range of 0-400V systems, 2 for double range up to 800V or so
 #define BALANCE_TOLERANCE	10 // i.e shunt if this many millivolts above average
@@ -17,6 +24,8 @@
 #define EEPROM_OFFSET	4
 enum { EEPROM_BLANK, EEPROM_CORRUPT, EEPROM_CORRECT };
 #define EEPROM_DISPLAY_BRIGHTNESS	120
+#define EEPROM_ENERGY_RING	256 // Monitor only, EepromRing of trip and lifetime energy totals
+#define EEPROM_EVENT_RING	1024 // Monitor only, EepromRing of event log batches
 
 // CAN PACKET IDs
 enum { CORE_BROADCAST_STATUS = CAN_BASE_ID,
@@ -34,6 +43,13 @@ enum { CORE_BROADCAST_STATUS = CAN_BASE_ID,
 #define CAN_ZERO_CURRENT		41
 #define CAN_EVSE_INTERFACE		45
 
+#define MONITOR_PACK_SUMMARY1		42 // Min, max and average cell mV, and the spread, big endian
+#define MONITOR_PACK_SUMMARY2		43 // Min and max cell module/cell, max temp (+40) and its module, cells balancing, cell count
+#define MONITOR_DIAGNOSTICS_REQUEST	46 // Any frame with this ID asks the Monitor for a diagnostics reply
+#define MONITOR_DIAGNOSTICS_REPLY	47
+#define MONITOR_ISOTP_REQUEST		48 // ISO-TP messages to the Monitor, and flow control for its replies
+#define MONITOR_ISOTP_REPLY			49
+
 enum { CORE_REQUEST_CONFIG = 51,
 	CORE_SEND_CONFIG1,
 	CORE_SEND_CONFIG2,
@@ -52,6 +68,13 @@ enum { BMS_REQUEST_DATA, BMS_REPLY1, BMS_REPLY2, BMS_REPLY3, BMS_REPLY4 };
 #define TC_CHARGER3_RX_ID	0x1806E8F4
 #define TC_CHARGER3_TX_ID	0x18FF50E8
 
+// Any TC charger, by J1939 address. Commands go to PGN 0x0600 with the charger as destination (bits 8-15),
+// and each charger broadcasts its status on PGN 0xFF50 with itself as source (bits 0-7)
+#define TC_CHARGER_COMMAND_ID	0x180600F4
+#define TC_CHARGER_COMMAND_MASK	0xFFFF00FF
+#define TC_CHARGER_STATUS_ID	0x18FF5000
+#define TC_CHARGER_STATUS_MASK	0xFFFFFF00
+
 // Motor Controller stuff
 enum { NO_MC, MC600C, MC1000C };
 enum { MC_STATUS_PACKET_ID = 50, MC_SET_THROTTLE_ID, MC_RECEIVE_SETTINGS_ID, MC_SEND_SETTINGS_ID };
@@ -83,38 +106,49 @@ enum { // MC settings
 	MC_IDLE_CURRENT,
 	MC_NUM_SETTINGS };
 unsigned char mcSettings[MC_NUM_SETTINGS];
-unsigned char mcMinimums[MC_NUM_SETTINGS] = { 8, 1, 5, 5, 0, 0, 0, 1, 0, 0 };
-unsigned char mcMaximums[MC_NUM_SETTINGS] = { 150, 180, 100, 100, 4, 3, 3, 3, 12, 20 };
+MONITOR_PROGMEM unsigned char mcMinimums[MC_NUM_SETTINGS] = { 8, 1, 5, 5, 0, 0, 0, 1, 0, 0 };
+MONITOR_PROGMEM unsigned char mcMaximums[MC_NUM_SETTINGS] = { 150, 180, 100, 100, 4, 3, 3, 3, 12, 20 };
 
 #ifdef MONITOR
-	char* mcErrors[MC_NUM_ERRORS] = {
-		"     Status: OK     ",
-		"  Status: Sleeping  ",
-		"     Desat fault     ",
-		"Current sensor fault",
-		"  Temp sensor fault  ", 
-		"    Undervoltage    ",
-		"     Overvoltage     ",
-		"   Low 12v supply   ",
-		"   Throttle error   ",
-		"   Thermal cutback   ",
-		"  Thermal shutdown  " };
-
-	char* mcUnits[MC_NUM_SETTINGS] = { "V", "V", "A", "A", "", "", "", "", "V", "A" };
-	char* mcNames[MC_NUM_SETTINGS] = {
-		" Min Batt Volts ",
-		" Max Motor Volts ",
-		"Max Motor Current",
-		" Max Batt Current ",
-		" Thrtl Ramp Rate ",
-		" Speed Control ",
-		" Torque Control ",
-		" Throttle Type ",
-		" Idle Voltage ",
-		" Idle Current " };
-
-	char* mcThrottleTypes[4] = { "", "     0-5V     ", "   0-5kohm   ", "     HEPA     " };
-	char* mcControlTypes[4] = { "    Linear    ", "Semiquadratic", "  Quadratic  ", "   Off   " };
+	const char mce0[] PROGMEM = "     Status: OK     ";
+	const char mce1[] PROGMEM = "  Status: Sleeping  ";
+	const char mce2[] PROGMEM = "     Desat fault     ";
+	const char mce3[] PROGMEM = "Current sensor fault";
+	const char mce4[] PROGMEM = "  Temp sensor fault  ";
+	const char mce5[] PROGMEM = "    Undervoltage    ";
+	const char mce6[] PROGMEM = "     Overvoltage     ";
+	const char mce7[] PROGMEM = "   Low 12v supply   ";
+	const char mce8[] PROGMEM = "   Throttle error   ";
+	const char mce9[] PROGMEM = "   Thermal cutback   ";
+	const char mce10[] PROGMEM = "  Thermal shutdown  ";
+	PROGMEM const char* const mcErrors[MC_NUM_ERRORS] = { mce0,mce1,mce2,mce3,mce4,mce5,mce6,mce7,mce8,mce9,mce10 };
+
+	// Units are short enough to store inline rather than through a pointer table
+	const char mcUnits[MC_NUM_SETTINGS][2] PROGMEM = { "V", "V", "A", "A", "", "", "", "", "V", "A" };
+
+	const char mcs0[] PROGMEM = " Min Batt Volts ";
+	const char mcs1[] PROGMEM = " Max Motor Volts ";
+	const char mcs2[] PROGMEM = "Max Motor Current";
+	const char mcs3[] PROGMEM = " Max Batt Current ";
+	const char mcs4[] PROGMEM = " Thrtl Ramp Rate ";
+	const char mcs5[] PROGMEM = " Speed Control ";
+	const char mcs6[] PROGMEM = " Torque Control ";
+	const char mcs7[] PROGMEM = " Throttle Type ";
+	const char mcs8[] PROGMEM = " Idle Voltage ";
+	const char mcs9[] PROGMEM = " Idle Current ";
+	PROGMEM const char* const mcNames[MC_NUM_SETTINGS] = { mcs0,mcs1,mcs2,mcs3,mcs4,mcs5,mcs6,mcs7,mcs8,mcs9 };
+
+	const char mct0[] PROGMEM = "";
+	const char mct1[] PROGMEM = "     0-5V     ";
+	const char mct2[] PROGMEM = "   0-5kohm   ";
+	const char mct3[] PROGMEM = "     HEPA     ";
+	PROGMEM const char* const mcThrottleTypes[4] = { mct0, mct1, mct2, mct3 };
+
+	const char mcc0[] PROGMEM = "    Linear    ";
+	const char mcc1[] PROGMEM = "Semiquadratic";
+	const char mcc2[] PROGMEM = "  Quadratic  ";
+	const char mcc3[] PROGMEM = "   Off   ";
+	PROGMEM const char* const mcControlTypes[4] = { mcc0, mcc1, mcc2, mcc3 };
 #endif
 
 
@@ -213,6 +247,7 @@ enum { // MPO functions
 #endif
 
 enum { SOC_PERCENT, SOC_AMPHOURS };
+#define CAN_SPEED_AUTO	0 // Otherwise the CAN_SPEED setting is the bit rate index + 1
 
 enum { // Settings
 	PACK_CAPACITY,
@@ -251,6 +286,9 @@ enum { // Settings
 	BUZZER_ON,
 	USE_FAHRENHEIT,
 	SOC_DISPLAY,
+	CAN_SPEED,
+	BMS_POLL_LOAD,
+	PACK_SUMMARY_PERIOD,
 	NUM_SETTINGS };
 
 unsigned char settings[NUM_SETTINGS] = {
@@ -290,9 +328,12 @@ unsigned char settings[NUM_SETTINGS] = {
 	0,		// Buzzer on (0 Off, 1 On)
 	0,		// Use fahrenheit (0 No, 1 Yes)
 	0,		// SoC display (0 Percentage, 1 Amp-hours)
+	2,		// CAN speed (0 Auto, 1 125k, 2 250k, 3 500k, 4 1M)
+	0,		// BMS poll load (% of bus, 0 = leave polling to the Core)
+	0,		// Pack summary period (x0.1s, 0 = don't send)
 };
 
-unsigned char minimums[NUM_SETTINGS] = {
+MONITOR_PROGMEM unsigned char minimums[NUM_SETTINGS] = {
 	1,		// Pack capacity (Ah x 5)
 	0,		// Soc warning (%)
 	5,		// Full voltage (x2V)
@@ -329,9 +370,12 @@ unsigned char minimums[NUM_SETTINGS] = {
 	0,		// Buzzer on
 	0,		// Use fahrenheit
 	0,		// SoC percent or amp-hours
+	0,		// CAN speed
+	0,		// BMS poll load
+	0,		// Pack summary period
 };
 
-unsigned char maximums[NUM_SETTINGS] = {
+MONITOR_PROGMEM unsigned char maximums[NUM_SETTINGS] = {
 	250,		// Pack capacity (Ah x 5)
 	99,		// Soc warning (%)
 	251,		// Full voltage (x2V)
@@ -368,9 +412,12 @@ unsigned char maximums[NUM_SETTINGS] = {
 	1,		// Buzzer on
 	1,		// Use fahrenheit
 	1,		// SoC percent or amp hours
+	4,		// CAN speed
+	50,		// BMS poll load
+	100,	// Pack summary period
 };
 
-unsigned char bms16maximums[NUM_SETTINGS] = {
+MONITOR_PROGMEM unsigned char bms16maximums[NUM_SETTINGS] = {
     250,		// Pack capacity (Ah x 5)
     99,		// Soc warning (%)
     70,		// Full voltage (x2V normally, x1V for BMS16
@@ -407,6 +454,9 @@ unsigned char bms16maximums[NUM_SETTINGS] = {
     1,		// Buzzer on
     1,		// Use fahrenheit
     1,		// SoC percent or amp hours
+    4,		// CAN speed
+    50,		// BMS poll load
+    100,	// Pack summary period
 };
 
 // Reassign a couple of settings that the BMS16 needs to be different
@@ -450,13 +500,19 @@ unsigned char bms16maximums[NUM_SETTINGS] = {
 	const char s32[] PROGMEM =  "    Buzzer On    ";
 	const char s33[] PROGMEM =  " Use Fahrenheit ";
 	const char s34[] PROGMEM =  "   SoC Display   ";
+	const char s35[] PROGMEM =  "    CAN Speed    ";
+	const char s36[] PROGMEM =  "  BMS Poll Load  ";
+	const char s37[] PROGMEM =  " Summary Period ";
 	PROGMEM const char* const generalSettingsLabels[] = { s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,
-		s11,s12,s14,s15,s18b,s16,s17,s18,s21,s22,s23,s24,s25,s26,s27,s28,s29,s13,s20,s30,s31,s32,s33,s34 };
-	char* allSettingsUnits[] = { "Ah", "%", "V", "A", "A", "C", "V", "%", "", "%", "%", "%", "%", // temp gauge cold
-		"V", "V", "V", "V", "C", "C", "V", "A", "V", "A", "min", "", "", "", "", "", "", "", "%", "", "", "" };
+		s11,s12,s14,s15,s18b,s16,s17,s18,s21,s22,s23,s24,s25,s26,s27,s28,s29,s13,s20,s30,s31,s32,s33,s34,s35,s36,s37 };
+	const char allSettingsUnits[][4] PROGMEM = { "Ah", "%", "V", "A", "A", "C", "V", "%", "", "%", "%", "%", "%", // temp gauge cold
+		"V", "V", "V", "V", "C", "C", "V", "A", "V", "A", "min", "", "", "", "", "", "", "", "%", "", "", "", "", "%", "s" };
 #endif
 
-unsigned char bmsCellCounts[16] = { 9, 4, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+#ifndef MAX_BMS_MODULES
+	#define MAX_BMS_MODULES	16
+#endif
+unsigned char bmsCellCounts[MAX_BMS_MODULES] = { 9, 4, 10 };
 //unsigned char bmsCellCounts[24] = { 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12 };
 
 // Utility functions
@@ -11,9 +11,13 @@
 #define DISPLAY_TYPE	ILI9341		// SSD1289 or ILI9325 or ILI9341
 #define SHOW_TOUCH_LOCATION	0 // Used for debugging touchscreen - writes touched coords in top left
 #define FAKE_EVMS	0 // Use to test things if no EVMS is present
+#define SHOW_DIAGNOSTICS	0 // Adds a stack and SRAM usage page to the end of the page cycle
+#define CAN_BRIDGE	0 // Streams received CAN frames out of USART0 (PE1) at 1Mbaud, and takes injected ones on PE0.
+						// tools/canbridge.py turns the stream into candump logs
 #define MONITOR // Modifies some stuff in the Common.h header
 
-#define MAX_BMS_MODULES	16
+#define MAX_BMS_MODULES	16 // Up to 32, but the cell bar graph needs at least a pixel per cell (320 cells). Changing this
+							// moves the settings checksum in EEPROM, so settings reset once
 
 #define __DELAY_BACKWARD_COMPATIBLE__
 
@@ -29,8 +33,11 @@
 
 #include "Common.h"
 #include "Touchscreen.h"
+#include "Sprites.h"
 #include "config.h"
 #include "can_lib.h"
+#include "IsoTp.h"
+#include "EepromRing.h"
 
 // Colour theme - only partially implemented
 #define BGND_COLOUR		DARK_GRAY
@@ -62,48 +69,150 @@ typedef struct
 	int x, y, width;
 	U16 colour;
 	U16 tcolour;
-	char* text;
+	const char* text; // In flash
 	bool isTouched;
 } Button;
 
-Button enterSetupButton = { 160, 30, 220, L_GRAY, TEXT_COLOUR, "Enter Setup", false };
-Button resetSocButton = { 160, 70, 220, D_GRAY, TEXT_COLOUR, "Reset SoC", false };
-Button zeroCurrentButton = { 160, 110, 220, D_GRAY, TEXT_COLOUR, "Zero Current", false };
-Button displayOffButton = { 160, 150, 220, D_GRAY, TEXT_COLOUR, "Display Off", false };
-Button exitOptionsButton = { 160, 190, 220, L_GRAY, TEXT_COLOUR, "Exit Options", false };
-
-Button nextBmsModuleButton = { 260, 200, 100, L_GRAY, TEXT_COLOUR, "Next", false };
-Button prevBmsModuleButton = { 60, 200, 100, L_GRAY, TEXT_COLOUR, "Prev", false };
-
-Button changeSetupPageButtonLeft = { 40, 25, 80, BLUE, TEXT_COLOUR, "<", false };
-Button changeSetupPageButtonRight = { 280, 25, 80, BLUE, TEXT_COLOUR, ">", false };
-Button changeParameterButtonLeft = { 40, 90, 80, BLUE, TEXT_COLOUR, "<", false };
-Button changeParameterButtonRight = { 280, 90, 80, BLUE, TEXT_COLOUR, ">", false };
-Button changeValueButtonLeft = { 40, 155, 80, BLUE, TEXT_COLOUR, "<", false };
-Button changeValueButtonRight = { 280, 155, 80, BLUE, TEXT_COLOUR, ">", false };
-Button exitSetupButton = { 160, 207, 160, L_GRAY, TEXT_COLOUR, "Exit Setup", false };
+const char bEnterSetup[] PROGMEM = "Enter Setup";
+const char bResetSoc[] PROGMEM = "Reset SoC";
+const char bZeroCurrent[] PROGMEM = "Zero Current";
+const char bDisplayOff[] PROGMEM = "Display Off";
+const char bPowerOff[] PROGMEM = "Power off";
+const char bExitOptions[] PROGMEM = "Exit Options";
+const char bNext[] PROGMEM = "Next";
+const char bPrev[] PROGMEM = "Prev";
+const char bLeft[] PROGMEM = "<";
+const char bRight[] PROGMEM = ">";
+const char bExitSetup[] PROGMEM = "Exit Setup";
+const char bResetTrip[] PROGMEM = "Reset Trip";
+const char bOlder[] PROGMEM = "Older";
+const char bNewer[] PROGMEM = "Newer";
+
+Button enterSetupButton = { 160, 30, 220, L_GRAY, TEXT_COLOUR, bEnterSetup, false };
+Button resetSocButton = { 160, 70, 220, D_GRAY, TEXT_COLOUR, bResetSoc, false };
+Button zeroCurrentButton = { 160, 110, 220, D_GRAY, TEXT_COLOUR, bZeroCurrent, false };
+Button displayOffButton = { 160, 150, 220, D_GRAY, TEXT_COLOUR, bDisplayOff, false };
+Button exitOptionsButton = { 160, 190, 220, L_GRAY, TEXT_COLOUR, bExitOptions, false };
+
+Button nextBmsModuleButton = { 260, 200, 100, L_GRAY, TEXT_COLOUR, bNext, false };
+Button prevBmsModuleButton = { 60, 200, 100, L_GRAY, TEXT_COLOUR, bPrev, false };
+
+Button resetTripButton = { 160, 207, 160, L_GRAY, TEXT_COLOUR, bResetTrip, false };
+
+Button olderEventsButton = { 260, 207, 100, L_GRAY, TEXT_COLOUR, bOlder, false };
+Button newerEventsButton = { 60, 207, 100, L_GRAY, TEXT_COLOUR, bNewer, false };
+
+Button changeSetupPageButtonLeft = { 40, 25, 80, BLUE, TEXT_COLOUR, bLeft, false };
+Button changeSetupPageButtonRight = { 280, 25, 80, BLUE, TEXT_COLOUR, bRight, false };
+Button changeParameterButtonLeft = { 40, 90, 80, BLUE, TEXT_COLOUR, bLeft, false };
+Button changeParameterButtonRight = { 280, 90, 80, BLUE, TEXT_COLOUR, bRight, false };
+Button changeValueButtonLeft = { 40, 155, 80, BLUE, TEXT_COLOUR, bLeft, false };
+Button changeValueButtonRight = { 280, 155, 80, BLUE, TEXT_COLOUR, bRight, false };
+Button exitSetupButton = { 160, 207, 160, L_GRAY, TEXT_COLOUR, bExitSetup, false };
 
 Button* touchedButton = 0;
 
-short cellVoltages[MAX_BMS_MODULES][12]; // Buffer for holding last cell voltages
+// Last cell voltages, packed as 13-bit millivolt values (0-8191) back to back in cell order.
+// SRAM per module: 19.5 bytes of voltages + 2 temperatures + 12 bar graph cache + 1 cell count = 34.5 bytes
+// (was 39 with a short per cell), so 32 modules take 1104 bytes rather than 1248.
+#define CELLS_PER_MODULE	12
+#define CELL_BITS			13
+#define CELL_MAX_MV			((1<<CELL_BITS)-1)
+U8 cellStore[(MAX_BMS_MODULES*CELLS_PER_MODULE*CELL_BITS+7)/8 + 1]; // Spare byte so a 3-byte access never overruns
 U8 bmsTemps[MAX_BMS_MODULES][2];
 
+static inline U16 GetCellVoltage(U8 module, U8 cell)
+{
+	U16 bit = (module*CELLS_PER_MODULE + cell)*CELL_BITS;
+	U8* p = &cellStore[bit>>3];
+	unsigned long bits = p[0] | ((U16)p[1]<<8) | ((unsigned long)p[2]<<16);
+	return (bits >> (bit&0x07)) & CELL_MAX_MV;
+}
+
+// Only called from CAN RX, so writes never interleave. The main loop may see a half updated value of
+// the cell being written, same as with the old 16-bit array
+static inline void SetCellVoltage(U8 module, U8 cell, U16 millivolts)
+{
+	if (millivolts > CELL_MAX_MV) millivolts = CELL_MAX_MV;
+	U16 bit = (module*CELLS_PER_MODULE + cell)*CELL_BITS;
+	U8 shift = bit&0x07;
+	U8* p = &cellStore[bit>>3];
+	unsigned long mask = (unsigned long)CELL_MAX_MV << shift;
+	unsigned long bits = p[0] | ((U16)p[1]<<8) | ((unsigned long)p[2]<<16);
+	bits = (bits & ~mask) | ((unsigned long)millivolts << shift);
+	p[0] = bits;
+	p[1] = bits>>8;
+	p[2] = bits>>16;
+}
+
 long current = 0;
-int currentSensorTimeout = 0;
 char haveReceivedCurrentData = false;
+short coreStatus;
+volatile uint8_t evmsStatusBytes[8];
 
 unsigned char mcStatusBytes[8];
-short mcCanTimeout = 0;
 
 char haveReceivedEVMSData = 0;
 char haveReceivedMCData = 0;
 
-short chargerCommsTimeout[3] = { 0, 0, 0 };
 
 short ticksSincePowerOn = 0;
 
+// Stack monitoring. All RAM above the static variables is painted with STACK_CANARY before main() runs,
+// so however much of it is still unmarked is the closest the stack has ever come to the globals.
+// STACK_PROBE() records the deepest stack seen so far in the current context, and sits at the bottom
+// of the longest call chains (touch handling, CAN RX and TX).
+#define STACK_CANARY	0xC5
+extern U8 _end; // First byte after .data and .bss, from the linker (there's no heap)
+extern U8 __stack; // Last byte of RAM
+
+enum { STACK_MAIN, STACK_TIMER0_ISR, STACK_TIMER1_ISR, STACK_NUM_CONTEXTS };
+volatile U8 stackContext = STACK_MAIN;
+volatile U16 stackMaxDepth[STACK_NUM_CONTEXTS]; // Bytes of stack in use, including whatever was interrupted
+#define STACK_PROBE()	do { U16 depth = RAMEND - SP; \
+	if (depth > stackMaxDepth[stackContext]) stackMaxDepth[stackContext] = depth; } while (0)
+
+// CAN bus statistics. Just counters bumped as frames are polled or sent, and rolled over once a second
+// by CanStatsSecond(), so they're cheap enough to leave running all the time.
+// Bus load counts every frame we see (the RX MOBs accept all IDs) at its unstuffed length, plus a
+// quarter again on the data bytes as a typical bit stuffing allowance.
+#define CAN_STD_FRAME_BITS	47 // SOF to IFS, with no data
+#define CAN_EXT_FRAME_BITS	67
+enum { CAN_STAT_CORE, CAN_STAT_CURRENT, CAN_STAT_MC, CAN_STAT_BMS, CAN_STAT_CHARGER, CAN_STAT_OTHER, CAN_NUM_STAT_IDS };
+enum { CAN_ACK_ERRORS, CAN_FORM_ERRORS, CAN_CRC_ERRORS, CAN_STUFF_ERRORS, CAN_BIT_ERRORS, CAN_NUM_ERROR_TYPES }; // CANSTMOB order
+typedef struct {
+	U16 frames[CAN_NUM_STAT_IDS]; // This second so far
+	U16 framesPerSecond[CAN_NUM_STAT_IDS]; // Last whole second
+	U16 txFrames, txPerSecond;
+	unsigned long bits; // Estimated bus bits this second so far
+	U8 busLoad; // Percent, last whole second
+	U16 mobsFull; // RX polls that found every MOB holding a frame, so some may have been missed
+	U16 mobErrors[CAN_NUM_ERROR_TYPES];
+	U16 txErrors;
+} CanStats;
+CanStats canStats;
+
+// Bus off supervisor. The controller stops dead if its transmit error count passes 255, and won't come back
+// by itself, so this restarts it, leaving longer each time in case whatever's wrong with the bus hasn't gone away
+#define CAN_MAX_BACKOFF		32 // Quarter seconds between restarts, the wait doubles up to this
+enum { CAN_BUS_OK, CAN_BUS_OFF, CAN_RECOVERING };
+typedef struct {
+	U8 state;
+	U8 backoff; // Quarter seconds to wait after the next restart
+	U8 wait; // Quarter seconds until the next restart
+	U16 busOffs;
+	U16 restarts;
+	U16 downTime; // Milliseconds since we went bus off
+	U16 lastRecovery; // Milliseconds from going bus off to the first frame received after the restart
+} CanSupervisor;
+volatile CanSupervisor canSupervisor;
+
+U8 canBitrate = CAN_BITRATE_250; // can_bitrate_t the controller is running at
+U8 canSpeedSetting; // settings[CAN_SPEED] it was started with
+U8 canDetectNext = CAN_BITRATE_250; // Bit rate an auto speed restart listens for next
+
 // Display pages
-enum { EVMS_CORE, MOTOR_CONTROLLER, TC_CHARGER, BMS_SUMMARY, BMS12_DETAILS, NUM_KNOWN_DEVICES }; 
+enum { EVMS_CORE, MOTOR_CONTROLLER, TC_CHARGER, BMS_SUMMARY, BMS12_DETAILS, CELL_RESISTANCE, CELL_DRIFT, TRIP_COMPUTER, EVENT_LOG, DIAGNOSTICS, CAN_DIAGNOSTICS, DATA_AGE, NUM_KNOWN_DEVICES }; 
 
 // Function declarations
 void PrepareCanRX(unsigned char mob);
@@ -113,10 +222,20 @@ void HandleTouchUp();
 void DoSetupButtons(char isKeyRepeat);
 void TransmitSettings();
 void TransmitGaugeState();
+void TransmitDiagnostics();
+void HandleIsoTpRequest();
+void StartConfigSync(bool verify);
+void ConfigSyncTimeouts();
+void FinishConfigSync();
+void BmsPollPriorities();
+void BmsPollUpdate();
+void FreshnessTimeouts();
+void PackSummaryUpdate();
+void EnergySaveTimeouts();
+void DriftAnalysisStep();
+void EventLogUpdate();
 static inline void Beep(short ticks);
 static inline void UpdateBuzzer();
-void AddDecimalPoint(char* buffer);
-void AddDecimalPoint2(char* buffer);
 void SetupPorts();
 char LoadSettingsFromEEPROM();
 void SaveSettingsToEEPROM();
@@ -127,9 +246,16 @@ void RenderMainViewNoCurrentSensor();
 void RenderLiteIdleScreen();
 void RenderMCStatus();
 void RenderChargerStatus();
-void RenderThreeChargerStatus();
+void RenderMultiChargerStatus();
 void RenderBMSSummary();
 void RenderBMSDetails();
+void RenderDiagnostics();
+void RenderCanDiagnostics();
+void RenderDataAge();
+void RenderCellResistance();
+void RenderCellDrift();
+void RenderTripComputer();
+void RenderEventLog();
 void RenderWarningOverlay();
 void RenderOptionsButtons();
 static inline void RenderBorderBox(int lx, int ly, int rx, int ry, U16 Fcolor, U16 Bcolor);
@@ -139,16 +265,473 @@ void RenderSettings();
 // Global variables
 
 #define NUM_RX_MOBS	4 // Four RX MOBs for CAN messages
-st_cmd_t rxMsg[NUM_RX_MOBS];
-U8 rxData[NUM_RX_MOBS][8];
+#if CAN_BRIDGE
+	#define BRIDGE_SLOT		NUM_RX_MOBS // Frames injected over the UART are decoded straight into this extra slot
+	#define NUM_RX_SLOTS	(NUM_RX_MOBS+1)
+#else
+	#define NUM_RX_SLOTS	NUM_RX_MOBS
+#endif
+st_cmd_t rxMsg[NUM_RX_SLOTS];
+U8 rxData[NUM_RX_SLOTS][8];
 
 U8 txData[8]; // CAN transmit buffer
 
+// Bulk reads over ISO-TP. The first byte of a request is the service, replies echo it with 0x40 set
+// (or are 0x7F, service for one we don't know), UDS style
+enum { ISOTP_READ_SETTINGS = 1, ISOTP_READ_DIAGNOSTICS, ISOTP_READ_BLACK_BOX, ISOTP_ARM_BLACK_BOX };
+#define ISOTP_POSITIVE_REPLY	0x40
+#define ISOTP_NEGATIVE_REPLY	0x7F
+IsoTpLink isoTp;
+U8 isoTpRequest[12];
+U8 isoTpReply[96]; // Left alone until the reply has gone
+
+// CAN black box: the last BLACK_BOX_FRAMES frames received, kept by the RX poll until SetError() sees a
+// new error, which freezes it so whatever led up to the fault can be read out over ISO-TP
+// (ISOTP_READ_BLACK_BOX, a few frames per request). ISOTP_ARM_BLACK_BOX empties it and starts it
+// again, optionally with a filter: frames are kept if (ID & mask) == match, or if not, with exclude set.
+// Multi-byte fields go over ISO-TP big endian, both ways
+#define BLACK_BOX_FRAMES		24
+#define BLACK_BOX_PER_READ		5 // Frames per ISO-TP reply
+#define BLACK_BOX_EXTENDED		0x80000000UL // Set in the ID of extended frames
+typedef struct {
+	U32 id;
+	U16 stamp; // msClock, as for freshness
+	U8 length;
+	U8 data[8];
+} BlackBoxFrame;
+typedef struct {
+	bool frozen;
+	U8 trigger; // Error that froze it
+	U16 frozenAt; // msClock
+	U8 head; // Where the next frame goes
+	U8 count;
+	U32 match, mask;
+	bool exclude;
+	BlackBoxFrame frames[BLACK_BOX_FRAMES];
+} BlackBox;
+BlackBox blackBox; // Only touched with interrupts off, outside of the RX poll
+
+// Pulling the Core's copy of its settings. One CORE_REQUEST_CONFIG gets all five CORE_SEND_ blocks back
+// to back, and we ask again (for up to a couple of seconds) until they've all turned up. The same
+// exchange reads back whatever TransmitSettings() sent, to confirm the Core took it.
+// The IDs overlap the motor controller's: CORE_REQUEST_CONFIG (51) is MC_SET_THROTTLE_ID, so nothing is
+// asked once a motor controller has been heard, and CORE_SEND_CONFIG1/2 (52/53) are MC_RECEIVE_SETTINGS_ID
+// and MC_SEND_SETTINGS_ID. So blocks are only listened for while syncing, never while the motor controller
+// has a settings request outstanding, a block that turns up twice for one request is thrown away (one
+// of the copies wasn't from the Core), and late ones are dropped rather than taken as motor controller
+// settings
+#define CORE_CONFIG_SETTINGS	32 // settings[] the Core keeps, in four blocks of 8
+#define CONFIG_SYNC_BLOCKS		5 // CORE_SEND_CONFIG1-4, CORE_SEND_CELL_NUMS
+#define CONFIG_SYNC_ALL			((1<<CONFIG_SYNC_BLOCKS)-1)
+#define CONFIG_SYNC_TRIES		4
+#define CONFIG_SYNC_TIMEOUT		2 // Quarter seconds to wait for replies before asking again
+#define CONFIG_SYNC_BOOT_WAIT	4 // Quarter seconds at power up for a motor controller to be heard before asking
+#define MC_SETTINGS_TIMEOUT		4 // Quarter seconds the motor controller gets to answer a settings request
+typedef struct {
+	volatile bool active;
+	bool verifying; // Checking the Core against coreConfig rather than taking its copy
+	bool askMc; // Read back the motor controller's settings when done
+	volatile U8 mcWait; // Quarter seconds left for the motor controller's answer, cleared by the RX poll
+	volatile U8 received; // Bit per block, set by the RX poll
+	volatile U8 seen; // Blocks heard since the last CORE_REQUEST_CONFIG, duplicates included
+	volatile U8 quiet; // Quarter seconds since the last request in which the Core could still be answering it
+	U8 triesLeft;
+	U8 timer;
+	U8 data[CONFIG_SYNC_BLOCKS*8]; // Settings, then cell counts packed two to a byte as in TransmitSettings()
+} ConfigSync;
+ConfigSync configSync;
+// Settings as the Core last confirmed them, in the same layout, so only blocks that changed get sent
+U8 coreConfig[CONFIG_SYNC_BLOCKS*8];
+bool coreConfigKnown = false;
+U8 mcConfig[8]; // Likewise for the motor controller, packed as it last reported them
+volatile bool mcConfigKnown = false;
+
+// Polling the BMS modules ourselves, for installs without a Core (BMS_POLL_LOAD setting, 0 = off).
+// Modules are picked by stride scheduling: each pick, every configured module gains credit (more if
+// it's near a limit or balancing) and the one with the most is asked next, so it's plain round robin
+// when nothing's urgent. Requests are spaced so our own traffic stays within the bus load budget
+#define BMS_POLL_URGENT_WEIGHT	4 // Urgent modules get asked this many times as often
+#define BMS_POLL_NEAR_LIMIT		50 // mV from the min/max voltage settings that counts as near
+#define BMS_REQUEST_BITS		70 // Rough frame sizes on the wire, including stuffing
+#define BMS_REPLY_BITS			125
+typedef struct {
+	U8 credit;
+	U8 latency; // ms from request to first reply, last time it answered (255 = longer)
+	U16 requestTime; // msClock when last asked
+	U16 missed; // Asked again before it answered
+} BmsPollModule;
+#if MAX_BMS_MODULES > 32
+#error "BmsPoller keeps a bit per module in a U32"
+#endif
+typedef struct {
+	BmsPollModule module[MAX_BMS_MODULES];
+	U32 configured; // Bit per module with cells, and per module near a limit or balancing, updated at 4Hz
+	U32 urgent;
+	volatile U32 waiting; // Asked and not answered yet
+	volatile U32 replied; // Heard from since cycleStart
+	U16 cycleStart;
+	U16 refreshTime; // ms for every configured module to answer, last time round
+	U16 lastRequest;
+	U16 interval; // ms until the next request, from the size of the last one
+} BmsPoller;
+BmsPoller bmsPoller;
+volatile U16 msClock; // Counts at 976Hz, near enough milliseconds
+
+// When each source of data was last heard from. Stamps are msClock back-dated by how long the frame sat
+// in its MOB, going by the CANSTM capture, so they're good to a millisecond however late the RX poll is.
+// Sources go stale (and stay stale until heard from again) once their timeout passes
+#define CAN_TIMER_PRESCALE	15 // CANTCON for the CAN timer at Fclkio/8/16, i.e 8us ticks
+#define CAN_TICKS_PER_MS	125
+enum { SOURCE_CORE, SOURCE_CURRENT, SOURCE_MC, SOURCE_CHARGER, SOURCE_BMS, NUM_SOURCES = SOURCE_BMS+MAX_BMS_MODULES };
+const U16 sourceTimeouts[SOURCE_BMS+1] PROGMEM = { 1000, 1000, 1000, 3000, 2000 }; // ms. The last is for each BMS module
+typedef struct {
+	U16 stamp; // msClock when last heard from
+	U16 interval; // ms between the last two updates, 0 if it's just come back
+	bool fresh;
+} Freshness;
+volatile Freshness freshness[NUM_SOURCES];
+
+// Called from CAN RX
+static inline void MarkFresh(U8 source, U16 stamp)
+{
+	volatile Freshness* f = &freshness[source];
+	f->interval = f->fresh ? stamp - f->stamp : 0;
+	f->stamp = stamp;
+	f->fresh = true;
+}
+
+static inline bool IsStale(U8 source)
+{
+	return !freshness[source].fresh;
+}
+
+// Cell statistics kept up to date as the BMS frames come in. Each module's are redone from its own cells
+// when its voltages arrive (or its cell count changes), and SummarisePack() only has to combine modules
+typedef struct {
+	U16 min, max;
+	U8 minCell, maxCell; // Numbered from 1, as displayed
+	U8 balancing; // Cells above balanceVoltageNow
+	long sum;
+} ModuleStats;
+volatile ModuleStats moduleStats[MAX_BMS_MODULES];
+U16 balanceVoltageNow = 5000; // Updated at 4Hz
+
+typedef struct {
+	U16 minVoltage, maxVoltage, avgVoltage;
+	U8 minModule, minCell, maxModule, maxCell;
+	long packVoltage;
+	U8 maxTemp, maxTempModule; // +40 as the BMS sends it, 0 if no sensors
+	U8 balancing;
+} PackSummary;
+
+// Called from CAN RX, or with interrupts off
+static void UpdateModuleStats(U8 module)
+{
+	U16 min = 0xFFFF, max = 0;
+	U8 minCell = 0, maxCell = 0, balancing = 0;
+	long sum = 0;
+	for (U8 n=0; n<bmsCellCounts[module]; n++)
+	{
+		U16 v = GetCellVoltage(module, n);
+		if (v < min)
+		{
+			min = v;
+			minCell = n+1;
+		}
+		if (v > max)
+		{
+			max = v;
+			maxCell = n+1;
+		}
+		if (v > balanceVoltageNow) balancing++;
+		sum += v;
+	}
+	volatile ModuleStats* m = &moduleStats[module];
+	m->min = min;
+	m->max = max;
+	m->minCell = minCell;
+	m->maxCell = maxCell;
+	m->balancing = balancing;
+	m->sum = sum;
+}
+
+// Coulomb and energy counting, done on every current sensor frame over the time since the last one (from
+// the CANSTM captures, so it doesn't matter how late the RX poll gets to them). All 32-bit fixed point:
+// charge builds up in mA.ms and energy in W.ms, and whole units move into the totals with the remainder
+// carried. Positive current is taken as out of the pack (REVERSE_CURRENT_DISPLAY flips it), and energy
+// in while the Core isn't charging counts as regen
+#define CHARGE_UNIT		36000000UL // mA.ms in 0.01Ah
+#define ENERGY_UNIT		3600000UL // W.ms in 1Wh
+#define ENERGY_MAX_GAP	1000 // ms between frames beyond which we don't guess what happened in between
+#define ENERGY_RING_SLOTS		12
+#define ENERGY_SAVE_INTERVAL	1200 // Quarter seconds between saves while the totals are changing, i.e 5 minutes
+typedef struct {
+	U32 ahOut, ahIn; // 0.01Ah
+	U32 whOut, whIn, whRegen;
+} EnergyTotals;
+typedef struct {
+	EnergyTotals trip, lifetime; // As stored in energyRing
+} EnergyRecord;
+typedef struct {
+	U32 chargeOut, chargeIn; // Part units, mA.ms
+	U32 energyOut, energyIn; // W.ms
+	long lastCurrent;
+	U16 lastStamp, lastCaptured;
+	U8 tickRemainder; // CAN timer ticks short of a whole ms
+	bool haveLast;
+	bool dirty; // Totals have changed since they were saved
+} EnergyCounter;
+volatile EnergyRecord energy;
+volatile EnergyCounter energyCounter;
+volatile U16 bmsPackVoltage; // 0.1V, from the cells at 4Hz, for when the Core's isn't available
+EepromRing energyRing;
+EnergyRecord energySaving; // Being written by EepromRingPoll()
+volatile bool resetTripRequested = false;
+
+// Exponentially weighted averages of the current out of the pack (mA, negative while charging), each
+// updated per current frame as avg += (I - avg)*dt/tau with tau a power of two, so there's no division.
+// The time remaining estimate picks between them to suit how far off empty (or full) is
+#define CONSUMPTION_AVERAGES	3
+#define CONSUMPTION_MIN_SHIFT	13 // tau = 2^13ms (8s), then 2^16 (65s) and 2^19 (9 minutes)
+#define CONSUMPTION_SHIFT_STEP	3
+#define CONSUMPTION_MIN_RATE	300 // mA, below which the pack isn't really going anywhere
+volatile long consumption[CONSUMPTION_AVERAGES];
+volatile bool consumptionSeeded = false;
+
+// Called from CAN RX with the current (mA) over the last dt ms, never more than ENERGY_MAX_GAP
+static inline void UpdateConsumption(long current, U16 dt)
+{
+	if (!consumptionSeeded) // Start from where we are rather than crawling up from zero
+	{
+		for (U8 k=0; k<CONSUMPTION_AVERAGES; k++) consumption[k] = current;
+		consumptionSeeded = true;
+		return;
+	}
+	U8 shift = CONSUMPTION_MIN_SHIFT - 4;
+	for (U8 k=0; k<CONSUMPTION_AVERAGES; k++, shift += CONSUMPTION_SHIFT_STEP)
+		consumption[k] += (((current - consumption[k]) >> 4) * dt) >> shift; // In 16mA steps, so it fits in 32 bits
+}
+
+// Cell DC internal resistance, from how each cell's voltage moves when the current steps. The current
+// counts as steady once it's stayed within IR_STEADY_TOLERANCE for IR_SETTLE_MS (long enough to cover
+// the BMS sampling before it replies), and each group of four cells remembers the steady current at its
+// last reply. When the next reply for the group comes in at a steady current at least IR_MIN_STEP away,
+// the change in each cell's voltage over the change in current is averaged into its resistance
+#define IR_STEADY_TOLERANCE	20 // 0.1A
+#define IR_SETTLE_MS		500
+#define IR_MIN_STEP			200 // 0.1A
+#define IR_NOT_STEADY		(-32768)
+#define IR_UNKNOWN			0xFFFF
+#define IR_AVERAGE_SHIFT	3 // Each step counts for 1/8
+U16 cellResistance[MAX_BMS_MODULES*CELLS_PER_MODULE]; // 10 micro-ohm units, IR_UNKNOWN until the first step
+int irGroupCurrent[MAX_BMS_MODULES][3]; // 0.1A, or IR_NOT_STEADY
+volatile int steadyCurrent = IR_NOT_STEADY; // 0.1A
+int irPlateau; // Where the current settled, 0.1A
+U16 irPlateauStamp;
+volatile U16 irSteps = 0; // Steps of at least IR_MIN_STEP seen, for display
+
+// Background watch for cells drifting away from the rest, well before they reach the hard limits. Every
+// DRIFT_SWEEP_MS a sweep averages each cell's deviation from its module's mean, and each module mean's
+// from the pack mean, one module per pass of the main loop. A cell's deviation from the pack mean is
+// then just the sum of the two, as the averages are linear. Cells past the limits make up the alert list
+#define DRIFT_SWEEP_MS		4000
+#define DRIFT_FRACTION		5 // Bits of fraction in the averages, i.e 1/32mV, covering +-1V
+#define DRIFT_SHIFT			6 // Each sweep counts for 1/64, so about a 4 minute time constant
+#define DRIFT_WARMUP		16 // Sweeps before a module's cells can be flagged
+#define DRIFT_CELL_LIMIT	25 // mV from the module mean
+#define DRIFT_PACK_LIMIT	40 // mV from the pack mean
+#define DRIFT_ALERTS		8
+typedef struct {
+	U8 module, cell; // Cell numbered from 1, as displayed
+	S16 deviation; // mV
+	bool fromPack; // Past DRIFT_PACK_LIMIT rather than DRIFT_CELL_LIMIT
+} DriftAlert;
+typedef struct {
+	bool running;
+	U8 module; // Next to do
+	U16 sweepStart;
+	U16 packMean;
+	U8 found;
+	DriftAlert building[DRIFT_ALERTS];
+} DriftSweep;
+S16 cellDrift[MAX_BMS_MODULES*CELLS_PER_MODULE]; // Averaged deviation from the module mean, 1/32mV
+S16 moduleDrift[MAX_BMS_MODULES]; // Averaged deviation of the module mean from the pack mean
+U8 driftSweeps[MAX_BMS_MODULES]; // Sweeps each module has been in, up to DRIFT_WARMUP
+DriftSweep driftSweep;
+DriftAlert driftAlerts[DRIFT_ALERTS]; // From the last complete sweep, worst first
+U8 numDriftAlerts = 0;
+
+// Event log. Events collect in SRAM in batches of EVENT_BATCH, and a batch goes to its own slot of
+// eventRing once it's full or has waited EVENT_FLUSH_DELAY, written in the background by
+// EepromRingPoll(). Events are stamped with which power up they happened in and the seconds since.
+// The viewer reads the log straight out of EEPROM a page at a time
+#define EVENT_BATCH			4
+#define EVENT_RING_SLOTS	80 // 320 events, 2800 bytes of EEPROM
+#define EVENT_FLUSH_DELAY	30 // Seconds
+#define EVENTS_PER_PAGE		7
+enum { EVENT_NONE, EVENT_POWER_ON, EVENT_ERROR, EVENT_STATE, EVENT_CHARGE_START, EVENT_CHARGE_END, EVENT_BUS_OFF };
+typedef struct {
+	U8 kind;
+	U8 value; // Error, state or SoC %, depending on kind
+	U16 boot;
+	U32 seconds;
+} Event;
+typedef struct {
+	Event events[EVENT_BATCH]; // Oldest first, EVENT_NONE past the end of a short batch
+} EventBatch;
+EepromRing eventRing;
+EventBatch eventBatch; // Filling
+EventBatch eventWriting; // Being written by EepromRingPoll()
+volatile U8 eventsPending = 0;
+volatile U8 eventLogChanges = 0; // Bumped with every event, so the viewer knows to redraw
+U16 bootNumber;
+volatile U32 secondsSincePowerOn = 0;
+U16 eventPage = 0;
+
+// From anywhere, including interrupts. If a batch fills while the last is still being written, the
+// rest are lost
+void LogEvent(U8 kind, U8 value)
+{
+	U8 sreg = SREG;
+	cli();
+	if (eventsPending < EVENT_BATCH)
+	{
+		Event* e = &eventBatch.events[eventsPending++];
+		e->kind = kind;
+		e->value = value;
+		e->boot = bootNumber;
+		e->seconds = secondsSincePowerOn;
+		eventLogChanges++;
+	}
+	SREG = sreg;
+}
+
+// Percent, from the Core's Ah left and the pack capacity
+static int StateOfCharge()
+{
+	int ampHours = (evmsStatusBytes[1]<<8) + evmsStatusBytes[2];
+	return Cap(201L*(long)ampHours/2L/(long)(settings[PACK_CAPACITY]*PACK_CAPACITY_MULTIPLIER*10), 0, 100); // 201L/2L is for rounding instead of truncating
+}
+
+// Called from CAN RX for each current frame, with the current in mA (positive out of the pack)
+static void TrackCurrentSteps(long current, U16 stamp)
+{
+	if (current > 1600000L) current = 1600000L; // Keeps clear of IR_NOT_STEADY, and differences between two
+	if (current < -1600000L) current = -1600000L; // currents here and in EstimateResistance() within an int
+	int i = current/100;
+	if (Abs(i - irPlateau) > IR_STEADY_TOLERANCE)
+	{
+		irPlateau = i;
+		irPlateauStamp = stamp;
+		steadyCurrent = IR_NOT_STEADY;
+	}
+	else if (steadyCurrent == IR_NOT_STEADY && (U16)(stamp - irPlateauStamp) >= IR_SETTLE_MS)
+	{
+		static int lastSteady = IR_NOT_STEADY;
+		if (lastSteady != IR_NOT_STEADY && Abs(i - lastSteady) >= IR_MIN_STEP) irSteps++;
+		steadyCurrent = lastSteady = i;
+	}
+}
+
+// Called from CAN RX with a BMS_REPLY1-3 group's new voltages, before they replace the old ones.
+// One division per reply, then a multiply per cell
+static void EstimateResistance(U8 module, U8 group, U8* data)
+{
+	int now = IsStale(SOURCE_CURRENT) ? IR_NOT_STEADY : steadyCurrent;
+	int before = irGroupCurrent[module][group];
+	irGroupCurrent[module][group] = now;
+	if (now == IR_NOT_STEADY || before == IR_NOT_STEADY) return;
+	int step = now - before;
+	if (Abs(step) < IR_MIN_STEP) return;
+
+	long scale = (1000L<<12)/step; // mV per 0.1A is 1000 of our units, with 12 bits of fraction
+	for (U8 n=0; n<4; n++)
+	{
+		U8 cell = group*4 + n;
+		if (cell >= bmsCellCounts[module]) break;
+		int drop = Cap((int)GetCellVoltage(module, cell) - ((data[n*2]<<8) + data[n*2+1]), -1000, 1000);
+		long sample = ((long)drop*scale) >> 12;
+		if (sample < 0) sample = 0; // Noise, or it hadn't settled
+		if (sample > IR_UNKNOWN-1) sample = IR_UNKNOWN-1;
+		U16* r = &cellResistance[module*CELLS_PER_MODULE + cell];
+		if (*r == IR_UNKNOWN)
+			*r = sample;
+		else
+			*r += (sample - (long)*r) >> IR_AVERAGE_SHIFT;
+	}
+}
+
+// Moves whole units out of a remainder into the trip and lifetime totals
+static inline void EnergyCarry(volatile U32* remainder, U32 unit, volatile U32* trip, volatile U32* lifetime)
+{
+	if (*remainder < unit) return; // Most frames, so no division
+	U32 units = *remainder / unit;
+	*remainder -= units*unit;
+	*trip += units;
+	*lifetime += units;
+}
+
+// Called from CAN RX with the new current in mA, and when and where in the CAN timer it was captured
+static void IntegrateEnergy(long newCurrent, U16 stamp, U16 captured)
+{
+	volatile EnergyCounter* e = &energyCounter;
+	if (settings[REVERSE_CURRENT_DISPLAY]) newCurrent = -newCurrent;
+	U16 gap = stamp - e->lastStamp;
+	bool integrate = e->haveLast && gap <= ENERGY_MAX_GAP;
+
+	// The CAN timer wraps every 524ms, so msClock decides how many times it went round
+	long ticks = (U16)(captured - e->lastCaptured);
+	ticks += ((long)gap*CAN_TICKS_PER_MS - ticks + 32768) & ~0xFFFFL;
+	long current = (e->lastCurrent + newCurrent)/2; // Trapezoidal
+	e->lastCurrent = newCurrent;
+	e->lastStamp = stamp;
+	e->lastCaptured = captured;
+	e->haveLast = true;
+	if (!integrate || ticks <= 0) return;
+
+	ticks += e->tickRemainder;
+	U16 dt = ticks / CAN_TICKS_PER_MS;
+	e->tickRemainder = ticks - (long)dt*CAN_TICKS_PER_MS;
+	UpdateConsumption(current, dt);
+
+	U16 voltage; // 0.1V
+	if (IsStale(SOURCE_CORE))
+		voltage = bmsPackVoltage;
+	else
+		voltage = (evmsStatusBytes[3]<<8) + evmsStatusBytes[4];
+	long power = (long)voltage*(current/100)/100; // W, from 0.1V and 0.1A
+
+	if (current >= 0)
+		e->chargeOut += (U32)current*dt;
+	else
+		e->chargeIn += (U32)-current*dt;
+	if (power >= 0)
+		e->energyOut += (U32)power*dt;
+	else
+		e->energyIn += (U32)-power*dt;
+
+	volatile EnergyTotals* t = &energy.trip;
+	volatile EnergyTotals* l = &energy.lifetime;
+	EnergyCarry(&e->chargeOut, CHARGE_UNIT, &t->ahOut, &l->ahOut);
+	EnergyCarry(&e->chargeIn, CHARGE_UNIT, &t->ahIn, &l->ahIn);
+	EnergyCarry(&e->energyOut, ENERGY_UNIT, &t->whOut, &l->whOut);
+	if (e->energyIn >= ENERGY_UNIT)
+	{
+		U32 whIn = t->whIn;
+		EnergyCarry(&e->energyIn, ENERGY_UNIT, &t->whIn, &l->whIn);
+		if (coreStatus != CHARGING)
+		{
+			t->whRegen += t->whIn - whIn;
+			l->whRegen += t->whIn - whIn;
+		}
+	}
+	e->dirty = true;
+}
+
 char buffer[30]; // Used for sprintf functions
 
 short ticks = 0; // For main loop timing
 
-volatile uint8_t evmsStatusBytes[8];
 
 signed char displayedPage = EVMS_CORE;
 
@@ -156,7 +739,13 @@ volatile bool displayNeedsFullRedraw = true;
 bool showOptionsButtons;
 bool showStartupScreen = true;
 
-short coreStatus;
+// Last drawn state of each cell bar graph bar: height<<2 | colour class (0 = normal, 1 = red, 2 = orange)
+#define BAR_CACHE_INVALID	0xFF
+U8 cellBarCache[MAX_BMS_MODULES*12];
+int cellBarCount = 0; // numCells the cache was drawn for
+
+short socBarHeight = -1; // Rows of the SoC battery graphic currently filled, -1 = none (just the empty outline)
+unsigned int socBarColour;
 char isBMS16 = false; // Monitor can tell the difference based on CAN data, changes displays etc a little
 char isActuallyBMS12i = false; // has a bit of a dirty hack to differentiate BMS16 and BMS12i
 
@@ -170,7 +759,7 @@ short touchTimer;
 int touchX, touchY;
 int touchBufferX[10], touchBufferY[10];
 
-enum { NOTHING_TO_SEND, SEND_RESET_SOC, SEND_ZERO_CURRENT, SEND_ENTER_SETUP, SEND_GAUGE_STATE, SEND_SETTINGS, SEND_ACK_ERROR };
+enum { NOTHING_TO_SEND, SEND_RESET_SOC, SEND_ZERO_CURRENT, SEND_ENTER_SETUP, SEND_GAUGE_STATE, SEND_SETTINGS, SEND_ACK_ERROR, SEND_DIAGNOSTICS };
 short canToGo;
 
 short displayBrightness = 255;
@@ -191,7 +780,14 @@ short currentBmsModule = 0;
 
 short mcCurrentParameter = 0;
 
+// TC chargers, in the order they're first heard from. Each is identified by its J1939 address, and found
+// through a small hash of that address so decoding a frame costs the same however many chargers there are
+#define MAX_CHARGERS		8
+#define CHARGER_HASH_SIZE	16 // Power of two, bigger than MAX_CHARGERS so there's always an empty bucket
+#define CHARGER_ROWS		3 // Rows on the multi-charger page, which scrolls if there are more chargers
 typedef struct {
+	unsigned char address; // J1939 source address
+	unsigned char commsTimeout; // Counts down at 4Hz, zero means no comms
 	// These come from the charger
 	short instVoltage;
 	short instCurrent;
@@ -202,9 +798,120 @@ typedef struct {
 	short targetCurrent;
 	char controlBit;
 } ChargerData;
-ChargerData charger[3] = {{ 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0 }};
+ChargerData charger[MAX_CHARGERS];
+U8 chargerHash[CHARGER_HASH_SIZE]; // Slot+1 for each address, 0 = empty bucket
 char haveReceivedChargerData = false;
-char numChargers = 1; // Gets set to 3 if we receive data from third charger
+char numChargers = 0;
+U8 chargerScroll = 0; // First charger shown on the multi-charger page
+
+// Totals across all chargers, kept up to date as each frame arrives rather than summed when drawing
+long chargersTotalCurrent = 0;
+short chargersMaxVoltage = 0;
+U8 chargersMaxVoltageSlot = 0;
+U8 chargersFaulted = 0; // No comms, stopped by the BMS or reporting a fault
+
+static inline U8 ChargerFaulted(ChargerData* c)
+{
+	return c->commsTimeout == 0 || c->controlBit || (c->statusBits & 0b00011111);
+}
+
+// Slot for the charger at this address, adding it if it's new. Returns -1 if the table is full
+static signed char ChargerSlot(unsigned char address)
+{
+	U8 h = address & (CHARGER_HASH_SIZE-1);
+	while (chargerHash[h])
+	{
+		if (charger[chargerHash[h]-1].address == address) return chargerHash[h]-1;
+		h = (h+1) & (CHARGER_HASH_SIZE-1);
+	}
+
+	if (numChargers == MAX_CHARGERS) return -1;
+	memset(&charger[numChargers], 0, sizeof(ChargerData));
+	charger[numChargers].address = address;
+	chargerHash[h] = numChargers+1;
+	chargersFaulted++; // Nothing heard from it yet
+	if (numChargers == 1) displayNeedsFullRedraw = true; // Switch to the multi-charger layout
+	return numChargers++;
+}
+
+// Call after a charger's output voltage changes. Only has to look at the others if the highest one dropped
+static void UpdateChargersMaxVoltage(U8 slot)
+{
+	if (charger[slot].instVoltage >= chargersMaxVoltage)
+	{
+		chargersMaxVoltage = charger[slot].instVoltage;
+		chargersMaxVoltageSlot = slot;
+	}
+	else if (slot == chargersMaxVoltageSlot)
+	{
+		chargersMaxVoltage = 0;
+		for (U8 n=0; n<numChargers; n++)
+			if (charger[n].instVoltage >= chargersMaxVoltage)
+			{
+				chargersMaxVoltage = charger[n].instVoltage;
+				chargersMaxVoltageSlot = n;
+			}
+	}
+}
+
+static void ChargerStatusReceived(U8 slot, U8* data)
+{
+	ChargerData* c = &charger[slot];
+	U8 wasFaulted = ChargerFaulted(c);
+	chargersTotalCurrent -= c->instCurrent;
+
+	c->instVoltage = data[0]*256+data[1];
+	c->instCurrent = data[2]*256+data[3];
+	c->statusBits = data[4];
+	c->temp = data[5];
+	c->commsTimeout = 12; // Three seconds with 4hz loop
+
+	chargersTotalCurrent += c->instCurrent;
+	UpdateChargersMaxVoltage(slot);
+	chargersFaulted += ChargerFaulted(c) - wasFaulted;
+}
+
+// Command from the BMS to a charger, which is where the target values come from
+static void ChargerCommandReceived(U8 slot, U8* data)
+{
+	ChargerData* c = &charger[slot];
+	U8 wasFaulted = ChargerFaulted(c);
+
+	c->targetVoltage = data[0]*256+data[1];
+	c->targetCurrent = data[2]*256+data[3];
+	c->controlBit = data[4];
+
+	chargersFaulted += ChargerFaulted(c) - wasFaulted;
+}
+
+// Called at 4Hz
+static void ChargerCommsTimeouts()
+{
+	for (U8 n=0; n<numChargers; n++)
+	{
+		cli(); // Totals are also updated from CAN RX
+		ChargerData* c = &charger[n];
+		U8 wasFaulted = ChargerFaulted(c);
+		if (c->commsTimeout > 0 && --c->commsTimeout == 0)
+		{	// No data for a while - set values to zero
+			chargersTotalCurrent -= c->instCurrent;
+			c->instVoltage = 0;
+			c->instCurrent = 0;
+			c->statusBits = 0;
+			UpdateChargersMaxVoltage(n);
+			chargersFaulted += ChargerFaulted(c) - wasFaulted;
+		}
+		sei();
+	}
+
+	static U8 scrollTimer = 0;
+	if (numChargers > CHARGER_ROWS && ++scrollTimer == 8) // Scroll the multi-charger page every 2s
+	{
+		scrollTimer = 0;
+		chargerScroll += CHARGER_ROWS;
+		if (chargerScroll >= numChargers) chargerScroll = 0;
+	}
+}
 
 static inline bool ButtonTouched(Button* button)
 {
@@ -233,9 +940,364 @@ static inline void DisplayOn(bool on, bool shouldSaveToEEPROM)
 	}
 }
 
+// Paints the stack area before the C runtime starts. Naked and in .init1 so it runs with no stack frame
+// of its own, which is why it's in assembly (r1 isn't zeroed yet either)
+void PaintStack() __attribute__((naked, used, section(".init1")));
+void PaintStack()
+{
+	__asm__ __volatile__ (
+		"	ldi r30, lo8(_end)\n"
+		"	ldi r31, hi8(_end)\n"
+		"	ldi r24, %0\n"
+		"	ldi r25, hi8(__stack)\n"
+		"	rjmp 2f\n"
+		"1:	st Z+, r24\n"
+		"2:	cpi r30, lo8(__stack)\n"
+		"	cpc r31, r25\n"
+		"	brlo 1b\n"
+		"	breq 1b\n"
+		:: "M" (STACK_CANARY));
+}
+
+// Bytes of RAM the stack has never reached since power up
+U16 StackNeverUsed()
+{
+	const U8* p = &_end;
+	while (p <= &__stack && *p == STACK_CANARY) p++;
+	return p - &_end;
+}
+
+static inline U8 CanStatId(long packetID)
+{
+	if (packetID >= BMS_BASE_ID && packetID < BMS_BASE_ID+MAX_BMS_MODULES*10+10) return CAN_STAT_BMS;
+	if ((packetID & TC_CHARGER_COMMAND_MASK) == TC_CHARGER_COMMAND_ID
+		|| (packetID & TC_CHARGER_STATUS_MASK) == TC_CHARGER_STATUS_ID) return CAN_STAT_CHARGER;
+	switch (packetID)
+	{
+		case CORE_BROADCAST_STATUS:	return CAN_STAT_CORE;
+		case CAN_CURRENT_SENSOR_ID:	return CAN_STAT_CURRENT;
+		case MC_STATUS_PACKET_ID:
+		case MC_SEND_SETTINGS_ID:	return CAN_STAT_MC;
+	}
+	return CAN_STAT_OTHER;
+}
+
+static inline void CountCanFrame(long packetID, U8 extended, U8 length)
+{
+	canStats.frames[CanStatId(packetID)]++;
+	canStats.bits += (extended ? CAN_EXT_FRAME_BITS : CAN_STD_FRAME_BITS) + length*10;
+}
+
+static inline void CountMobErrors(U8 status)
+{
+	if (status == MOB_NOT_REACHED || status == MOB_DISABLE) return; // MOb wasn't armed, not a bus error
+	for (U8 n=0; n<CAN_NUM_ERROR_TYPES; n++)
+		if (status & (1<<n)) canStats.mobErrors[n]++;
+}
+
+// Frames that shouldn't hold up the main loop. They're queued and sent one at a time by the RX poll on
+// their own MOB, the same way as ISO-TP, so queueing never waits. Frames that don't fit are dropped and
+// counted as failed sends
+#define TX_QUEUE_SIZE	4 // Power of two
+typedef struct {
+	long id;
+	U8 length;
+	U8 data[8];
+} QueuedFrame;
+typedef struct {
+	QueuedFrame frame[TX_QUEUE_SIZE];
+	volatile U8 head, tail; // The frame at tail stays put until it's been sent, the MOB reads it from there
+	bool busy;
+	st_cmd_t cmd;
+} TxQueue;
+TxQueue txQueue;
+
+// Main loop only
+bool CanQueueTX(long packetID, const U8* data, U8 length)
+{
+	U8 head = txQueue.head;
+	U8 next = (head+1) & (TX_QUEUE_SIZE-1);
+	if (next == txQueue.tail)
+	{
+		cli();
+		canStats.txErrors++;
+		sei();
+		return false;
+	}
+	QueuedFrame* f = &txQueue.frame[head];
+	f->id = packetID;
+	f->length = length;
+	memcpy(f->data, data, length);
+	txQueue.head = next;
+	return true;
+}
+
+// Called from the RX poll
+static void CanQueuePoll()
+{
+	if (txQueue.busy)
+	{
+		U8 status = can_get_status(&txQueue.cmd);
+		if (status == CAN_STATUS_NOT_COMPLETED) return;
+		txQueue.busy = false;
+		canStats.txFrames++;
+		canStats.bits += (txQueue.cmd.ctrl.ide ? CAN_EXT_FRAME_BITS : CAN_STD_FRAME_BITS) + txQueue.cmd.dlc*10;
+		if (status == CAN_STATUS_ERROR)
+		{
+			canStats.txErrors++;
+			CountMobErrors(txQueue.cmd.status);
+		}
+		txQueue.tail = (txQueue.tail+1) & (TX_QUEUE_SIZE-1);
+	}
+	if (txQueue.tail == txQueue.head) return;
+
+	QueuedFrame* f = &txQueue.frame[txQueue.tail];
+	txQueue.cmd.pt_data = f->data;
+	txQueue.cmd.ctrl.ide = USE_29BIT_IDS;
+	if (USE_29BIT_IDS)
+		txQueue.cmd.id.ext = f->id;
+	else
+		txQueue.cmd.id.std = f->id;
+	txQueue.cmd.dlc = f->length;
+	txQueue.cmd.cmd = CMD_TX_DATA;
+	if (can_cmd(&txQueue.cmd) == CAN_CMD_ACCEPTED) txQueue.busy = true; // Otherwise no free MOB, try next time
+}
+
+// Called once a second
+void CanStatsSecond()
+{
+	cli(); // Counters are bumped from the TIMER0 ISR
+	for (U8 n=0; n<CAN_NUM_STAT_IDS; n++)
+	{
+		canStats.framesPerSecond[n] = canStats.frames[n];
+		canStats.frames[n] = 0;
+	}
+	canStats.txPerSecond = canStats.txFrames;
+	canStats.txFrames = 0;
+	unsigned long bits = canStats.bits;
+	canStats.bits = 0;
+	sei();
+
+	canStats.busLoad = Cap(bits / (Can_bitrate_kbps(canBitrate)*10L), 0, 100);
+}
+
+// Called from the RX poll. Checks the bus off flag as well as the state, so we notice even if it came and went
+static inline void CanCheckBusOff()
+{
+	if (!(CANGSTA & (1<<BOFF)) && !(CANGIT & (1<<BOFFIT))) return;
+	CANGIT = (1<<BOFFIT); // Write one to clear
+
+	if (canSupervisor.state == CAN_BUS_OK)
+	{
+		LogEvent(EVENT_BUS_OFF, 0);
+		canSupervisor.busOffs++;
+		canSupervisor.downTime = 0;
+		canSupervisor.backoff = 1;
+		canSupervisor.wait = 0;
+	}
+	canSupervisor.state = CAN_BUS_OFF;
+}
+
+// Chooses the bit rate from settings, or listens for it on the bus if that's set to auto, trying up to
+// tries bit rates (each up to 130ms on a quiet bus). Leaves the controller reset, ready for can_init()
+static void SelectCanBitrate(U8 tries)
+{
+	canSpeedSetting = settings[CAN_SPEED];
+	if (canSpeedSetting == CAN_SPEED_AUTO)
+	{
+		U8 found = can_detect_bitrate(canDetectNext, tries); // Last one found first, it's most likely
+		if (found != CAN_NO_BITRATE)
+			canBitrate = canDetectNext = found;
+		else // Stay where we were, and carry on from the next one untried
+			canDetectNext = (canDetectNext + tries) % CAN_NUM_BITRATES;
+	}
+	else
+		canBitrate = canDetectNext = canSpeedSetting-1;
+	can_select_bitrate(canBitrate);
+}
+
+// Resets the controller and re-arms all the receive MOBs. Called from the main loop, so with auto speed
+// it only listens at one bit rate each time, and the supervisor's next restart tries the next one
+static void CanRestart(U8 newState)
+{
+	canSupervisor.state = CAN_BUS_OFF; // Keeps the RX poll off the controller while it's listening
+	SelectCanBitrate(1);
+	cli(); // Keep the RX poll off the MOBs while they're cleared
+	can_init(0);
+	CANTCON = CAN_TIMER_PRESCALE;
+	for (int mob=0; mob<NUM_RX_MOBS; mob++) PrepareCanRX(mob);
+	energyCounter.haveLast = false; // CAN timer has started again
+	canSupervisor.state = newState;
+	sei();
+}
+
+// Called at 4Hz
+void CanSupervise()
+{
+	if (canSupervisor.state == CAN_BUS_OK) return;
+	if (canSupervisor.wait > 0)
+	{
+		canSupervisor.wait--;
+		return;
+	}
+
+	CanRestart(CAN_RECOVERING); // Until we hear something
+	canSupervisor.restarts++;
+	canSupervisor.wait = canSupervisor.backoff;
+	if (canSupervisor.backoff < CAN_MAX_BACKOFF) canSupervisor.backoff *= 2;
+}
+
+#if CAN_BRIDGE
+// CAN to UART bridge. Each record on the wire, in both directions, is
+//   0xA5, kind<<4 | length, [ID, 2 bytes standard or 4 extended], timestamp (2), data..., checksum
+// with everything big endian and the checksum the XOR of all the bytes after the 0xA5. Timestamps are
+// CANSTM captures, in 8us ticks of the CAN timer (CAN_TIMER_PRESCALE). A heartbeat at 4Hz carries CANTIM and the drop counters,
+// so the decoder never misses a timer wrap (every 0.52s). Injected frames have their timestamp ignored.
+// Nothing ever waits: records that don't fit in the TX ring are dropped and counted, as are injected
+// frames that arrive before the last one has been decoded.
+#define BRIDGE_UBRR			1 // 1Mbaud with U2X at 16MHz
+#define BRIDGE_SYNC			0xA5
+#define BRIDGE_TX_SIZE		128 // Power of two
+enum { BRIDGE_STD_FRAME, BRIDGE_EXT_FRAME, BRIDGE_HEARTBEAT };
+U8 bridgeTx[BRIDGE_TX_SIZE];
+volatile U8 bridgeTxHead, bridgeTxTail;
+volatile bool bridgeInjected = false; // The bridge slot holds a frame waiting to be decoded
+typedef struct {
+	U16 txDropped; // Records that didn't fit in the TX ring
+	U16 rxDropped; // Injected frames that arrived while the slot was full
+	U16 rxBad; // Injected records with a bad header or checksum
+} BridgeStats;
+volatile BridgeStats bridgeStats;
+
+void BridgeInit()
+{
+	UBRR0 = BRIDGE_UBRR;
+	UCSR0A = (1<<U2X0);
+	UCSR0C = (1<<UCSZ01) | (1<<UCSZ00); // 8N1
+	UCSR0B = (1<<RXEN0) | (1<<TXEN0) | (1<<RXCIE0);
+}
+
+// Queues one record, or drops the lot if it won't fit. Call with interrupts off
+static void BridgeSend(U8 kind, long id, U16 stamp, const U8* data, U8 length)
+{
+	U8 idBytes = (kind == BRIDGE_EXT_FRAME) ? 4 : (kind == BRIDGE_STD_FRAME) ? 2 : 0;
+	U8 space = (bridgeTxTail - bridgeTxHead - 1) & (BRIDGE_TX_SIZE-1);
+	if (space < 5 + idBytes + length)
+	{
+		bridgeStats.txDropped++;
+		return;
+	}
+
+	U8 head = bridgeTxHead;
+	U8 checksum = 0;
+	#define BRIDGE_PUT(b)	do { U8 b_ = (b); bridgeTx[head] = b_; checksum ^= b_; head = (head+1) & (BRIDGE_TX_SIZE-1); } while (0)
+	bridgeTx[head] = BRIDGE_SYNC;
+	head = (head+1) & (BRIDGE_TX_SIZE-1);
+	BRIDGE_PUT(kind<<4 | length);
+	while (idBytes--) BRIDGE_PUT(id >> (idBytes*8));
+	BRIDGE_PUT(stamp >> 8);
+	BRIDGE_PUT(stamp);
+	for (U8 n=0; n<length; n++) BRIDGE_PUT(data[n]);
+	#undef BRIDGE_PUT
+	bridgeTx[head] = checksum;
+	bridgeTxHead = (head+1) & (BRIDGE_TX_SIZE-1);
+
+	UCSR0B |= (1<<UDRIE0);
+}
+
+// Called from the RX poll straight after can_get_status(), while CANPAGE still points at the MOB
+static inline void BridgeFrame(U8 mob)
+{
+	U8 kind = rxMsg[mob].ctrl.ide ? BRIDGE_EXT_FRAME : BRIDGE_STD_FRAME;
+	long id = rxMsg[mob].ctrl.ide ? rxMsg[mob].id.ext : rxMsg[mob].id.std;
+	BridgeSend(kind, id, CANSTM, rxData[mob], rxMsg[mob].dlc);
+}
+
+// Called at 4Hz
+void BridgeHeartbeat()
+{
+	U8 data[6];
+	cli();
+	data[0] = bridgeStats.txDropped >> 8;	data[1] = bridgeStats.txDropped;
+	data[2] = bridgeStats.rxDropped >> 8;	data[3] = bridgeStats.rxDropped;
+	data[4] = bridgeStats.rxBad >> 8;		data[5] = bridgeStats.rxBad;
+	BridgeSend(BRIDGE_HEARTBEAT, 0, CANTIM, data, 6);
+	sei();
+}
+
+SIGNAL(USART0_UDRE_vect)
+{
+	UDR0 = bridgeTx[bridgeTxTail];
+	bridgeTxTail = (bridgeTxTail+1) & (BRIDGE_TX_SIZE-1);
+	if (bridgeTxTail == bridgeTxHead) UCSR0B &= ~(1<<UDRIE0); // Ring's empty
+}
+
+// Decodes injected frames a byte at a time, straight into the bridge slot
+SIGNAL(USART0_RX_vect)
+{
+	static U8 pos = 0, idBytes, length, checksum;
+	static long id;
+	U8 c = UDR0;
+
+	if (pos == 0)
+	{
+		if (c == BRIDGE_SYNC) pos = 1;
+		return;
+	}
+
+	if (pos == 1)
+	{
+		U8 kind = c >> 4;
+		length = c & 0x0F;
+		if ((kind != BRIDGE_STD_FRAME && kind != BRIDGE_EXT_FRAME) || length > 8)
+		{
+			bridgeStats.rxBad++;
+			pos = 0;
+			return;
+		}
+		if (bridgeInjected) // Still waiting to be decoded
+		{
+			bridgeStats.rxDropped++;
+			pos = 0;
+			return;
+		}
+		rxMsg[BRIDGE_SLOT].ctrl.ide = (kind == BRIDGE_EXT_FRAME);
+		rxMsg[BRIDGE_SLOT].dlc = length;
+		idBytes = (kind == BRIDGE_EXT_FRAME) ? 4 : 2;
+		checksum = c;
+		id = 0;
+		pos = 2;
+		return;
+	}
+
+	U8 n = pos - 2; // Byte number after the header
+	pos++;
+	if (n < idBytes) id = (id << 8) | c;
+	else if (n < idBytes + 2) {} // Timestamp, meaningless for injected frames
+	else if (n < idBytes + 2 + length) rxData[BRIDGE_SLOT][n - idBytes - 2] = c;
+	else
+	{
+		if (c == checksum)
+		{
+			rxMsg[BRIDGE_SLOT].id.ext = id; // Low half overlaps id.std
+			bridgeInjected = true;
+		}
+		else
+			bridgeStats.rxBad++;
+		pos = 0;
+		return;
+	}
+	checksum ^= c;
+}
+#endif
+
 char toggley;
 SIGNAL(TIMER0_OVF_vect) // Called at 7812Hz, i.e every 2048 cycles of 16Mhz clock
 {
+	U8 oldStackContext = stackContext; // SaveSettingsToEEPROM() re-enables interrupts, so this can nest in TIMER1
+	stackContext = STACK_TIMER0_ISR;
+	STACK_PROBE();
+
 	ticks++; // Used for main loop timing
 
 #ifdef NEW_LCD
@@ -262,19 +1324,54 @@ SIGNAL(TIMER0_OVF_vect) // Called at 7812Hz, i.e every 2048 cycles of 16Mhz cloc
 	BACKLIGHT_PORT |= BACKLIGHT;
 #endif
 
+	if ((ticks & 0x07) == 0) msClock++;
+
+	if ((ticks & 0x07) == 0 && canSupervisor.state != CAN_BUS_OK)
+		if (canSupervisor.downTime < 0xFFFF) canSupervisor.downTime++; // Close enough to milliseconds
+
 	if (!canTXing && (ticks & 0x07) == 0) // every 8th interrupt, or around 1000hz
+		CanCheckBusOff();
+
+	if (!canTXing && canSupervisor.state != CAN_BUS_OFF && (ticks & 0x07) == 0)
 	{
+		U8 framesThisPoll = 0;
 		for (int mob=0; mob<NUM_RX_MOBS; mob++)
 		{
 			U8 temp = can_get_status(&rxMsg[mob]);
 
 			if (temp == CAN_STATUS_COMPLETED) // Then we have received a frame
+			{
+				if (canSupervisor.state == CAN_RECOVERING)
+				{
+					canSupervisor.state = CAN_BUS_OK;
+					canSupervisor.lastRecovery = canSupervisor.downTime;
+				}
+#if CAN_BRIDGE
+				BridgeFrame(mob);
+#endif
 				ProcessCanRX(mob);
+				framesThisPoll++;
+			}
 
 			if (temp == CAN_STATUS_ERROR)
+			{
+				CountMobErrors(rxMsg[mob].status);
 				PrepareCanRX(mob); // And flad a comms error?
+			}
 		}
+		if (framesThisPoll == NUM_RX_MOBS) canStats.mobsFull++;
+		IsoTpPoll(&isoTp);
+		CanQueuePoll();
+#if CAN_BRIDGE
+		if (bridgeInjected) // Decoded just like a frame off the bus
+		{
+			ProcessCanRX(BRIDGE_SLOT);
+			bridgeInjected = false;
+		}
+#endif
 	}
+
+	stackContext = oldStackContext;
 }
 
 SIGNAL(TIMER0_COMP_vect)
@@ -289,6 +1386,10 @@ SIGNAL(TIMER0_COMP_vect)
 
 SIGNAL(TIMER1_OVF_vect) // Interrupts at about 30Hz
 {
+	U8 oldStackContext = stackContext;
+	stackContext = STACK_TIMER1_ISR;
+	STACK_PROBE();
+
 	// Update display brightness
 	if (targetDisplayBrightness > displayBrightness)
 		displayBrightness += Cap(targetDisplayBrightness-displayBrightness, 0, 15); // Change by 15 maximum
@@ -320,6 +1421,8 @@ SIGNAL(TIMER1_OVF_vect) // Interrupts at about 30Hz
 	}
 
 	UpdateBuzzer();
+
+	stackContext = oldStackContext;
 }
 
 void PrepareCanRX(unsigned char mob)
@@ -334,11 +1437,36 @@ void PrepareCanRX(unsigned char mob)
 	while (can_cmd(&rxMsg[mob]) != CAN_CMD_ACCEPTED) { } // Wait for RX command to be completed
 }
 
+// Called from CAN RX for every frame, so kept to a test and a copy
+static inline void BlackBoxCapture(U8 mob, long packetID, U16 stamp)
+{
+	if (blackBox.frozen) return;
+	U32 id = packetID;
+	if (rxMsg[mob].ctrl.ide) id |= BLACK_BOX_EXTENDED;
+	if (((id & blackBox.mask) == blackBox.match) == blackBox.exclude) return;
+
+	BlackBoxFrame* f = &blackBox.frames[blackBox.head];
+	if (++blackBox.head == BLACK_BOX_FRAMES) blackBox.head = 0;
+	if (blackBox.count < BLACK_BOX_FRAMES) blackBox.count++;
+	f->id = id;
+	f->stamp = stamp;
+	f->length = rxMsg[mob].dlc;
+	memcpy(f->data, rxData[mob], 8);
+}
+
 // This function gets called when a new CAN message is received
 void ProcessCanRX(unsigned char mob)
 {
+	STACK_PROBE();
+
 	long packetID = rxMsg[mob].id.std;
 	if (USE_29BIT_IDS) packetID = rxMsg[mob].id.ext;
+	CountCanFrame(packetID, rxMsg[mob].ctrl.ide, rxMsg[mob].dlc);
+
+	U16 stamp = msClock; // Injected frames weren't captured, so they're stamped now
+	U16 captured = (mob < NUM_RX_MOBS) ? CANSTM : CANTIM; // CANPAGE still points at the MOB
+	stamp -= (U16)(CANTIM - captured) / CAN_TICKS_PER_MS;
+	BlackBoxCapture(mob, packetID, stamp);
 
 	if (packetID >= BMS_BASE_ID && packetID < BMS_BASE_ID+MAX_BMS_MODULES*10+10) // Packet ID within BMS module range
 	{
@@ -347,21 +1475,41 @@ void ProcessCanRX(unsigned char mob)
 
 		if (moduleID < MAX_BMS_MODULES)
 		{
+			if (packetType != BMS_REQUEST_DATA) MarkFresh(SOURCE_BMS + moduleID, stamp);
+
+			U32 bit = 1UL<<moduleID;
+			if (bmsPoller.waiting & bit && packetType != BMS_REQUEST_DATA)
+			{
+				U16 latency = msClock - bmsPoller.module[moduleID].requestTime;
+				bmsPoller.module[moduleID].latency = latency > 255 ? 255 : latency;
+				bmsPoller.waiting &= ~bit;
+				bmsPoller.replied |= bit;
+				if ((bmsPoller.replied & bmsPoller.configured) == bmsPoller.configured) // Whole pack refreshed
+				{
+					bmsPoller.refreshTime = msClock - bmsPoller.cycleStart;
+					bmsPoller.cycleStart = msClock;
+					bmsPoller.replied = 0;
+				}
+			}
+
+			if (packetType >= BMS_REPLY1 && packetType <= BMS_REPLY3)
+				EstimateResistance(moduleID, packetType-BMS_REPLY1, rxData[mob]);
+
 			switch (packetType)
 			{
 				case BMS_REPLY1:
 					for (int n=0; n<4; n++)
-						cellVoltages[moduleID][n] = (rxData[mob][n*2]<<8) + rxData[mob][n*2+1];
+						SetCellVoltage(moduleID, n, (rxData[mob][n*2]<<8) + rxData[mob][n*2+1]);
 					break;
 
 				case BMS_REPLY2:
 					for (int n=0; n<4; n++)
-						cellVoltages[moduleID][n+4] = (rxData[mob][n*2]<<8) + rxData[mob][n*2+1];
+						SetCellVoltage(moduleID, n+4, (rxData[mob][n*2]<<8) + rxData[mob][n*2+1]);
 					break;
 
 				case BMS_REPLY3:
 					for (int n=0; n<4; n++)
-						cellVoltages[moduleID][n+8] = (rxData[mob][n*2]<<8) + rxData[mob][n*2+1];
+						SetCellVoltage(moduleID, n+8, (rxData[mob][n*2]<<8) + rxData[mob][n*2+1]);
 					if (moduleID == 0 && isBMS16) isActuallyBMS12i = true; // If received this third voltages set, sender must be BMS12i
 					break;
 
@@ -370,27 +1518,69 @@ void ProcessCanRX(unsigned char mob)
 					bmsTemps[moduleID][1] = rxData[mob][1];
 					break;
 			}
+			if (packetType >= BMS_REPLY1 && packetType <= BMS_REPLY3) UpdateModuleStats(moduleID);
+		}
+	}
+	else if ((packetID & TC_CHARGER_COMMAND_MASK) == TC_CHARGER_COMMAND_ID) // BMS to charger, addressed by DA
+	{
+		signed char slot = ChargerSlot(packetID>>8);
+		if (slot >= 0) ChargerCommandReceived(slot, rxData[mob]);
+	}
+	else if ((packetID & TC_CHARGER_STATUS_MASK) == TC_CHARGER_STATUS_ID) // Charger broadcast, addressed by SA
+	{
+		signed char slot = ChargerSlot(packetID);
+		if (slot >= 0)
+		{
+			ChargerStatusReceived(slot, rxData[mob]);
+			MarkFresh(SOURCE_CHARGER, stamp);
+			haveReceivedChargerData = true;
 		}
 	}
+	else if (configSync.active && !configSync.mcWait && packetID >= CORE_SEND_CONFIG1 && packetID <= CORE_SEND_CELL_NUMS)
+	{
+		U8 bit = 1<<(packetID - CORE_SEND_CONFIG1);
+		if (configSync.seen & bit) configSync.received &= ~bit; // Twice for one request, so don't trust either
+		else if (rxMsg[mob].dlc == 8)
+		{
+			memcpy(&configSync.data[(packetID - CORE_SEND_CONFIG1)*8], rxData[mob], 8);
+			configSync.received |= bit;
+		}
+		configSync.seen |= bit;
+	}
+	else if (configSync.quiet && !configSync.mcWait && packetID >= CORE_SEND_CONFIG1 && packetID <= CORE_SEND_CELL_NUMS)
+	{
+		// Late answer to a sync that's over, which mustn't be taken for the motor controller's settings
+	}
 	else switch (packetID)
 	{
 		case CORE_BROADCAST_STATUS:
 			for (int n=0; n<8; n++) evmsStatusBytes[n] = rxData[mob][n];
 			evmsCommsTimer = 0;
+			MarkFresh(SOURCE_CORE, stamp);
 			haveReceivedEVMSData = true;
 			if (evmsStatusBytes[5] == 255)
 			{
 				isBMS16 = true;
-				displayOffButton.text = "Power off";
+				displayOffButton.text = bPowerOff;
 				//displayOffButton.colour = BLUE;
 			}
 			headlightsOn = evmsStatusBytes[6]>>7;
 			DisplayOn(targetDisplayBrightness != 255, false);
 			break;
 
+		case MONITOR_DIAGNOSTICS_REQUEST:
+			canToGo = SEND_DIAGNOSTICS;
+			break;
+
+		case MONITOR_ISOTP_REQUEST:
+			IsoTpFrameReceived(&isoTp, packetID, rxData[mob], rxMsg[mob].dlc);
+			break;
+
 		case CAN_CURRENT_SENSOR_ID:
 			current = ((long)rxData[mob][0]<<16) + ((long)rxData[mob][1]<<8) + (long)rxData[mob][2] - 8388608L;
-			currentSensorTimeout = 4; // 1 second timeout
+			MarkFresh(SOURCE_CURRENT, stamp);
+			IntegrateEnergy(current, stamp, captured);
+			TrackCurrentSteps(settings[REVERSE_CURRENT_DISPLAY] ? -current : current, stamp);
 			if (!haveReceivedCurrentData)
 			{
 				haveReceivedCurrentData = true;
@@ -400,7 +1590,7 @@ void ProcessCanRX(unsigned char mob)
 
 		case MC_STATUS_PACKET_ID:
 			for (int n=0; n<8; n++) mcStatusBytes[n] = rxData[mob][n];
-			mcCanTimeout = 4;
+			MarkFresh(SOURCE_MC, stamp);
 			haveReceivedMCData = true;
 			/*
 			if (showStartupScreen && ticksSincePowerOn >= 2) // MC has lower priority than EVMS, let EVMS go first
@@ -412,79 +1602,406 @@ void ProcessCanRX(unsigned char mob)
 			*/
 			break;
 
-		case MC_SEND_SETTINGS_ID:
-			for (int n=0; n<4; n++) mcSettings[n] = rxData[mob][n]; // First four match 1:1
-			mcSettings[MC_RAMP_RATE] = rxData[mob][4]&0b00001111; // Bottom 4 bits hold ramp rate
-			mcSettings[MC_SPEED_CONTROL_TYPE] = (rxData[mob][4]&0b00110000)>>4;
-			mcSettings[MC_TORQUE_CONTROL_TYPE] = (rxData[mob][4]&0b11000000)>>6;
-			for (int n=5; n<8; n++) mcSettings[n+2] = rxData[mob][n];
-			break;
+		case MC_SEND_SETTINGS_ID:
+			for (int n=0; n<4; n++) mcSettings[n] = rxData[mob][n]; // First four match 1:1
+			mcSettings[MC_RAMP_RATE] = rxData[mob][4]&0b00001111; // Bottom 4 bits hold ramp rate
+			mcSettings[MC_SPEED_CONTROL_TYPE] = (rxData[mob][4]&0b00110000)>>4;
+			mcSettings[MC_TORQUE_CONTROL_TYPE] = (rxData[mob][4]&0b11000000)>>6;
+			for (int n=5; n<8; n++) mcSettings[n+2] = rxData[mob][n];
+			memcpy(mcConfig, rxData[mob], 8);
+			mcConfigKnown = true;
+			configSync.mcWait = 0;
+			break;
+	}
+
+	if (mob < NUM_RX_MOBS) PrepareCanRX(mob); // Injected frames don't have a MOB to re-arm
+}
+
+void SetError(U8 newError)
+{
+	if (error != newError)
+	{
+		LogEvent(EVENT_ERROR, newError);
+		if (newError != NO_ERROR && newError != CORRUPT_EEPROM_ERROR && !blackBox.frozen && blackBox.count > 0)
+		{
+			U8 sreg = SREG; // Can be called from the touch handler
+			cli();
+			blackBox.frozen = true;
+			blackBox.trigger = newError;
+			blackBox.frozenAt = msClock;
+			SREG = sreg;
+		}
+		displayNeedsFullRedraw = true;
+		showOptionsButtons = false;
+		DisplayOn(true, false);
+		errorBeeperTimeout = 120; // Beep 120 times = 60 seconds max with new error
+	}
+	error = newError;
+}
+
+void CalculateNumCells()
+{
+	numCells = 0;
+	for (int id=0; id<MAX_BMS_MODULES; id++)
+	{
+		numCells += bmsCellCounts[id];
+		U8 sreg = SREG; // Also called at boot, before interrupts are on
+		cli(); // Stats are also updated from CAN RX
+		UpdateModuleStats(id);
+		SREG = sreg;
+	}
+}
+
+// Puts the module statistics together for the whole pack
+void SummarisePack(PackSummary* s)
+{
+	memset(s, 0, sizeof(PackSummary));
+	s->minVoltage = 5000;
+	for (U8 id=0; id<MAX_BMS_MODULES; id++)
+	{
+		if (bmsCellCounts[id] == 0) continue;
+		cli();
+		ModuleStats m = moduleStats[id];
+		sei();
+		if (m.min < s->minVoltage)
+		{
+			s->minVoltage = m.min;
+			s->minModule = id;
+			s->minCell = m.minCell;
+		}
+		if (m.max > s->maxVoltage)
+		{
+			s->maxVoltage = m.max;
+			s->maxModule = id;
+			s->maxCell = m.maxCell;
+		}
+		s->packVoltage += m.sum;
+		s->balancing += m.balancing;
+		for (U8 i=0; i<2; i++)
+			if (bmsTemps[id][i] > s->maxTemp)
+			{
+				s->maxTemp = bmsTemps[id][i];
+				s->maxTempModule = id;
+			}
+	}
+	if (numCells > 0) s->avgVoltage = s->packVoltage/numCells;
+}
+
+// Sends the pack summary every settings[PACK_SUMMARY_PERIOD] tenths of a second, so other nodes don't
+// have to collect every BMS frame themselves
+void PackSummaryUpdate()
+{
+	static U16 lastSent;
+	if (settings[PACK_SUMMARY_PERIOD] == 0 || numCells == 0) return;
+	cli();
+	U16 now = msClock;
+	sei();
+	if (now - lastSent < settings[PACK_SUMMARY_PERIOD]*100) return;
+	lastSent = now;
+
+	PackSummary s;
+	SummarisePack(&s);
+	U8 data[8];
+	U16 spread = s.maxVoltage - s.minVoltage;
+	data[0] = s.minVoltage>>8;	data[1] = s.minVoltage;
+	data[2] = s.maxVoltage>>8;	data[3] = s.maxVoltage;
+	data[4] = s.avgVoltage>>8;	data[5] = s.avgVoltage;
+	data[6] = spread>>8;		data[7] = spread;
+	CanQueueTX(MONITOR_PACK_SUMMARY1, data, 8);
+	data[0] = s.minModule;
+	data[1] = s.minCell;
+	data[2] = s.maxModule;
+	data[3] = s.maxCell;
+	data[4] = s.maxTemp;
+	data[5] = s.maxTempModule;
+	data[6] = s.balancing;
+	data[7] = numCells;
+	CanQueueTX(MONITOR_PACK_SUMMARY2, data, 8);
+}
+
+// Called at 4Hz. Moves the balance voltage the module statistics count against (same rule as the cell
+// bar graph), then works out which modules to poll, and which of them deserve it more often
+void BmsPollPriorities()
+{
+	PackSummary s;
+	SummarisePack(&s);
+	cli();
+	bmsPackVoltage = s.packVoltage/100; // For IntegrateEnergy()
+	sei();
+	balanceVoltageNow = 5000; // Not balancing
+	if (settings[BALANCE_VOLTAGE] < 251 && (coreStatus == CHARGING || isBMS16))
+		balanceVoltageNow = 2000+settings[BALANCE_VOLTAGE]*10;
+	else if (settings[BALANCE_VOLTAGE] == 251 && numCells > 0 && (coreStatus == CHARGING || isBMS16
+		|| (coreStatus == RUNNING && settings[STATIONARY_VERSION] == true)))
+		balanceVoltageNow = (s.minVoltage + s.maxVoltage) / 2 + BALANCE_TOLERANCE;
+
+	U16 low = (150+settings[BMS_MIN_VOLTAGE])*10 + BMS_POLL_NEAR_LIMIT;
+	U16 high = (200+settings[BMS_MAX_VOLTAGE])*10 - BMS_POLL_NEAR_LIMIT;
+	U32 configured = 0;
+	U32 urgent = 0;
+	for (int id=0; id<MAX_BMS_MODULES; id++)
+	{
+		if (bmsCellCounts[id] == 0) continue;
+		configured |= 1UL<<id;
+		cli();
+		ModuleStats m = moduleStats[id];
+		sei();
+		if (m.min < low || m.max > high || m.balancing > 0) urgent |= 1UL<<id; // Includes modules we haven't heard from
+	}
+	bmsPoller.configured = configured;
+	bmsPoller.urgent = urgent;
+}
+
+void BmsPollUpdate()
+{
+	if (settings[BMS_POLL_LOAD] == 0 || bmsPoller.configured == 0) return;
+
+	cli();
+	U16 now = msClock;
+	sei();
+	if (now - bmsPoller.lastRequest < bmsPoller.interval) return;
+
+	U8 pick = 0;
+	U8 mostCredit = 0;
+	for (U8 id=0; id<MAX_BMS_MODULES; id++)
+	{
+		if (!(bmsPoller.configured & 1UL<<id)) continue;
+		BmsPollModule* m = &bmsPoller.module[id];
+		U8 weight = (bmsPoller.urgent & 1UL<<id) ? BMS_POLL_URGENT_WEIGHT : 1;
+		m->credit = m->credit > 255-weight ? 255 : m->credit+weight;
+		if (m->credit > mostCredit) // Ties go to the lowest ID, which is what makes it round robin
+		{
+			mostCredit = m->credit;
+			pick = id;
+		}
+	}
+	BmsPollModule* m = &bmsPoller.module[pick];
+	U8 data[2] = { 0, 0 }; // Zero shunt voltage (i.e shunts off)
+	if (!CanQueueTX(BMS_BASE_ID + pick*10 + BMS_REQUEST_DATA, data, 2)) return; // Queue's full, it keeps its credit for next time
+	m->credit = 0;
+
+	cli(); // Replies are matched up by the RX poll
+	if (bmsPoller.waiting & 1UL<<pick) m->missed++;
+	bmsPoller.waiting |= 1UL<<pick;
+	m->requestTime = now;
+	sei();
+
+	// Space the next request so this one's share of the bus stays within budget
+	U16 bits = BMS_REQUEST_BITS + BMS_REPLY_BITS*((bmsCellCounts[pick]+3)/4 + 1); // Voltages plus temperatures
+	bmsPoller.interval = (unsigned long)bits*100 / ((unsigned long)Can_bitrate_kbps(canBitrate)*settings[BMS_POLL_LOAD]) + 1;
+	bmsPoller.lastRequest = now;
+}
+
+// Called at 4Hz
+void FreshnessTimeouts()
+{
+	for (U8 s=0; s<NUM_SOURCES; s++)
+	{
+		cli(); // Stamps are written by the RX poll
+		U16 age = msClock - freshness[s].stamp;
+		if (freshness[s].fresh && age > pgm_read_word(&sourceTimeouts[s < SOURCE_BMS ? s : SOURCE_BMS]))
+			freshness[s].fresh = false;
+		sei();
+	}
+}
+
+// Before the power goes. Finishes any background save, then writes the totals straight away
+static void SaveEnergyTotals()
+{
+	while (EepromRingBusy(&energyRing)) EepromRingPoll(&energyRing);
+	cli();
+	EnergyRecord r = energy;
+	energyCounter.dirty = false;
+	sei();
+	EepromRingWrite(&energyRing, &r);
+}
 
-		case TC_CHARGER1_RX_ID:
-			charger[0].targetVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[0].targetCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[0].controlBit = rxData[mob][4];
-			break;
+// Called at 4Hz. Saves the totals every so often while they're changing (a slot at a time, so the
+// EEPROM lasts, and in the background from the main loop), and resets the trip when asked
+void EnergySaveTimeouts()
+{
+	static U16 sinceSave = 0;
+	if (sinceSave < ENERGY_SAVE_INTERVAL) sinceSave++;
+	if (resetTripRequested)
+	{
+		cli();
+		memset((void*)&energy.trip, 0, sizeof(EnergyTotals));
+		sei();
+		resetTripRequested = false;
+		sinceSave = ENERGY_SAVE_INTERVAL;
+		energyCounter.dirty = true;
+	}
+	if (sinceSave == ENERGY_SAVE_INTERVAL && energyCounter.dirty && !EepromRingBusy(&energyRing))
+	{
+		cli();
+		energySaving = energy;
+		energyCounter.dirty = false;
+		sei();
+		EepromRingWriteLater(&energyRing, &energySaving);
+		sinceSave = 0;
+	}
+}
 
-		case TC_CHARGER1_TX_ID:
-			charger[0].instVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[0].instCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[0].statusBits = rxData[mob][4];
-			charger[0].temp = rxData[mob][5];
-			chargerCommsTimeout[0] = 12; // Three seconds with 4hz loop
-			haveReceivedChargerData = true;
-			break;
+static void DriftAverage(S16* average, int deviation, bool seed)
+{
+	S16 x = Cap(deviation, -1000, 1000) << DRIFT_FRACTION;
+	if (seed)
+		*average = x;
+	else
+		*average += ((long)x - *average + (1<<(DRIFT_SHIFT-1))) >> DRIFT_SHIFT;
+}
 
-		case TC_CHARGER2_RX_ID:
-			charger[1].targetVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[1].targetCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[1].controlBit = rxData[mob][4];
-			break;
+// Keeps the worst DRIFT_ALERTS of this sweep, worst first
+static void AddDriftAlert(U8 module, U8 cell, int deviation, bool fromPack)
+{
+	DriftAlert* list = driftSweep.building;
+	U8 slot = driftSweep.found;
+	while (slot > 0 && Abs(list[slot-1].deviation) < Abs(deviation)) slot--;
+	if (slot >= DRIFT_ALERTS) return;
+	if (driftSweep.found < DRIFT_ALERTS) driftSweep.found++;
+	for (U8 n=driftSweep.found-1; n>slot; n--) list[n] = list[n-1];
+	list[slot].module = module;
+	list[slot].cell = cell;
+	list[slot].deviation = deviation;
+	list[slot].fromPack = fromPack;
+}
 
-		case TC_CHARGER2_TX_ID:
-			charger[1].instVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[1].instCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[1].statusBits = rxData[mob][4];
-			charger[1].temp = rxData[mob][5];
-			chargerCommsTimeout[1] = 12; // Three seconds with 4hz loop
-			if (numChargers<2) numChargers = 2;
-			break;
+// Called every pass of the main loop. Does at most one module (12 cells) per call, or starts a sweep
+void DriftAnalysisStep()
+{
+	DriftSweep* d = &driftSweep;
+	if (!d->running)
+	{
+		cli();
+		U16 now = msClock;
+		sei();
+		if (now - d->sweepStart < DRIFT_SWEEP_MS || numCells == 0) return;
+		PackSummary s;
+		SummarisePack(&s);
+		d->sweepStart = now;
+		d->packMean = s.avgVoltage;
+		d->module = 0;
+		d->found = 0;
+		d->running = true;
+		return;
+	}
 
-		case TC_CHARGER3_RX_ID:
-			charger[2].targetVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[2].targetCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[2].controlBit = rxData[mob][4];
-			break;
+	U8 m = d->module++;
+	if (d->module == MAX_BMS_MODULES) d->running = false; // Last one, so publish once it's done
 
-		case TC_CHARGER3_TX_ID:
-			charger[2].instVoltage = rxData[mob][0]*256+rxData[mob][1];
-			charger[2].instCurrent = rxData[mob][2]*256+rxData[mob][3];
-			charger[2].statusBits = rxData[mob][4];
-			charger[2].temp = rxData[mob][5];
-			chargerCommsTimeout[2] = 12; // Three seconds with 4hz loop
-			numChargers = 3;
-			break;
+	U8 count = bmsCellCounts[m];
+	if (count > 0 && !IsStale(SOURCE_BMS + m))
+	{
+		cli(); // Stats and cells are updated by the RX poll
+		long sum = moduleStats[m].sum;
+		sei();
+		int moduleMean = sum/count;
+		bool seed = (driftSweeps[m] == 0);
+		bool warm = (driftSweeps[m] >= DRIFT_WARMUP);
+		if (!warm) driftSweeps[m]++;
+		DriftAverage(&moduleDrift[m], moduleMean - d->packMean, seed);
+
+		for (U8 n=0; n<count; n++)
+		{
+			cli();
+			int v = GetCellVoltage(m, n);
+			sei();
+			S16* average = &cellDrift[m*CELLS_PER_MODULE + n];
+			DriftAverage(average, v - moduleMean, seed);
+			if (!warm) continue;
+			int fromModule = *average >> DRIFT_FRACTION;
+			int fromPack = ((long)*average + moduleDrift[m]) >> DRIFT_FRACTION;
+			if (Abs(fromPack) >= DRIFT_PACK_LIMIT)
+				AddDriftAlert(m, n+1, fromPack, true);
+			else if (Abs(fromModule) >= DRIFT_CELL_LIMIT)
+				AddDriftAlert(m, n+1, fromModule, false);
+		}
 	}
+	else
+		driftSweeps[m] = 0; // Start again when it's back
 
-	PrepareCanRX(mob);
+	if (!d->running)
+	{
+		memcpy(driftAlerts, d->building, sizeof(driftAlerts));
+		numDriftAlerts = d->found;
+	}
 }
 
-void SetError(U8 newError)
+// Finds the log, and numbers this power up one after the last one in it
+static void EventLogInit()
 {
-	if (error != newError)
+	EepromRingInit(&eventRing, EEPROM_EVENT_RING, sizeof(EventBatch), EVENT_RING_SLOTS);
+	bootNumber = 1;
+	EventBatch last;
+	if (EepromRingRead(&eventRing, 0, &last)) bootNumber = last.events[0].boot + 1;
+	LogEvent(EVENT_POWER_ON, 0);
+}
+
+// Called every pass of the main loop
+void EventLogUpdate()
+{
+	EepromRingPoll(&eventRing);
+	if (eventsPending == 0 || EepromRingBusy(&eventRing)) return;
+	cli();
+	bool due = (eventsPending == EVENT_BATCH || secondsSincePowerOn - eventBatch.events[0].seconds >= EVENT_FLUSH_DELAY);
+	if (due)
 	{
-		displayNeedsFullRedraw = true;
-		showOptionsButtons = false;
-		DisplayOn(true, false);
-		errorBeeperTimeout = 120; // Beep 120 times = 60 seconds max with new error
+		eventWriting = eventBatch;
+		memset(&eventBatch, 0, sizeof(eventBatch));
+		eventsPending = 0;
 	}
-	error = newError;
+	sei();
+	if (due) EepromRingWriteLater(&eventRing, &eventWriting);
 }
 
-void CalculateNumCells()
+// Before the power goes. Finishes any background write, then writes what's left straight away
+static void EventLogFlush()
 {
-	numCells = 0;
-	for (int id=0; id<MAX_BMS_MODULES; id++) numCells += bmsCellCounts[id];
+	while (EepromRingBusy(&eventRing)) EepromRingPoll(&eventRing);
+	cli();
+	EventBatch batch = eventBatch;
+	memset(&eventBatch, 0, sizeof(eventBatch));
+	U8 pending = eventsPending;
+	eventsPending = 0;
+	sei();
+	if (pending) EepromRingWrite(&eventRing, &batch);
+}
+
+// Copies up to max events into out, newest first, after skipping the newest skip. Only reads as far
+// back in the EEPROM as it needs to
+static U8 ReadEvents(U16 skip, Event* out, U8 max)
+{
+	U8 found = 0;
+	EventBatch batch;
+	for (int age=-2; age<eventRing.count; age++) // -2 is the batch filling, -1 the one being written
+	{
+		if (age == -2)
+		{
+			cli();
+			batch = eventBatch;
+			sei();
+		}
+		else if (age == -1)
+		{
+			if (!EepromRingBusy(&eventRing)) continue;
+			batch = eventWriting;
+		}
+		else if (!EepromRingRead(&eventRing, age, &batch))
+			continue;
+
+		for (signed char n=EVENT_BATCH-1; n>=0; n--)
+		{
+			if (batch.events[n].kind == EVENT_NONE) continue;
+			if (skip > 0)
+				skip--;
+			else
+			{
+				out[found++] = batch.events[n];
+				if (found == max) return found;
+			}
+		}
+	}
+	return found;
 }
 
 void TestBeep(int delay, int osc)
@@ -511,7 +2028,7 @@ int main()
 
 	Touch_Init();
 
-	can_init(0);
+	EventLogInit(); // Before anything can be logged
 
 	char result = LoadSettingsFromEEPROM();
 	if (result == EEPROM_BLANK || result == EEPROM_CORRUPT)
@@ -519,10 +2036,26 @@ int main()
 		SetError(CORRUPT_EEPROM_ERROR);
 		SaveSettingsToEEPROM();
 	}
+
+	SelectCanBitrate(CAN_NUM_BITRATES); // Nothing else is running yet, so the whole search can block
+	can_init(0);
+	CANTCON = CAN_TIMER_PRESCALE; // For receive timestamps
+	IsoTpInit(&isoTp, MONITOR_ISOTP_REPLY, MONITOR_ISOTP_REQUEST, USE_29BIT_IDS, isoTpRequest, sizeof(isoTpRequest));
+#if CAN_BRIDGE
+	BridgeInit();
+#endif
 	
 	mcStatusBytes[0] = 0;
 	CalculateNumCells();
 
+	memset(cellResistance, 0xFF, sizeof(cellResistance)); // IR_UNKNOWN
+	for (int id=0; id<MAX_BMS_MODULES; id++)
+		for (int group=0; group<3; group++) irGroupCurrent[id][group] = IR_NOT_STEADY;
+
+	EepromRingInit(&energyRing, EEPROM_ENERGY_RING, sizeof(EnergyRecord), ENERGY_RING_SLOTS);
+	EnergyRecord savedEnergy;
+	if (EepromRingRead(&energyRing, 0, &savedEnergy)) energy = savedEnergy;
+
 	int lastDisplayBrightness = eeprom_read_byte((U8*)EEPROM_DISPLAY_BRIGHTNESS);
 	eeprom_write_byte(0, 0); // Park EEPROM pointer to prevent corruption
 	if (lastDisplayBrightness == 0) displayDimmed = false; else displayDimmed = true;
@@ -539,6 +2072,9 @@ int main()
 #endif
 
 	sei(); // Enable interrupts
+
+	StartConfigSync(false); // In case the Core has been swapped, or set up from somewhere else
+	configSync.timer = CONFIG_SYNC_BOOT_WAIT;
 	
 	while (1)
 	{
@@ -549,6 +2085,22 @@ int main()
 
 			if (ticksSincePowerOn < 100) ticksSincePowerOn++;
 
+			static U8 quarterSeconds = 0;
+			if (++quarterSeconds == 4)
+			{
+				quarterSeconds = 0;
+				secondsSincePowerOn++;
+				CanStatsSecond();
+			}
+			CanSupervise();
+			ConfigSyncTimeouts();
+			BmsPollPriorities();
+			FreshnessTimeouts();
+			EnergySaveTimeouts();
+#if CAN_BRIDGE
+			BridgeHeartbeat();
+#endif
+
 			// Check for comms timeouts
 			if (evmsCommsTimer < 100) evmsCommsTimer++;
 			if (evmsCommsTimer == 4)
@@ -561,24 +2113,9 @@ int main()
 
 			if (error == CORE_COMMS_ERROR && evmsCommsTimer < 4) SetError(NO_ERROR); // Self-reset if received data
 
-			if (currentSensorTimeout > 0)
-				currentSensorTimeout--;
-			else
-				current = 0;
-			
-			if (mcCanTimeout > 0) mcCanTimeout--; // Only used in the MC status page
+			if (IsStale(SOURCE_CURRENT)) current = 0;
 
-			for (int n=0; n<3; n++)
-			{
-				if (chargerCommsTimeout[n] > 0)
-					chargerCommsTimeout[n]--;
-				else
-				{	// No data for a while - set values to zero
-					charger[n].instVoltage = 0;
-					charger[n].instCurrent = 0;
-					charger[n].statusBits = 0;
-				}
-			}
+			ChargerCommsTimeouts();
 
 			if (FAKE_EVMS) // Then pretend we have received EVMS status message, and transmit BMS ID 0 request
 			{
@@ -596,7 +2133,7 @@ int main()
 				haveReceivedEVMSData = true;
 
 				txData[0] = txData[1] = 0; // Zero shunt voltage (i.e shunts off)
-				CanTX(BMS_BASE_ID + BMS_REQUEST_DATA, txData, 2, 0);
+				if (settings[BMS_POLL_LOAD] == 0) CanTX(BMS_BASE_ID + BMS_REQUEST_DATA, txData, 2, 0);
 			}
 		}
 
@@ -609,21 +2146,44 @@ int main()
 				case SEND_ENTER_SETUP:
 					txData[0] = CORE_SETUP_STATE;
 					CanTX(CORE_SET_STATE, txData, 1, 5);
-					txData[0] = 0;
-					CanTX(MC_RECEIVE_SETTINGS_ID, txData, 1, 0);
+					StartConfigSync(false); // Asks the motor controller for its settings once that's done
 					break;
 				case SEND_SETTINGS:		TransmitSettings(); break;
 				case SEND_GAUGE_STATE:	TransmitGaugeState(); break;
 				case SEND_ACK_ERROR: CanTX(CORE_ACKNOWLEDGE_ERROR, &error, 1, 5); break;
-				case POWER_OFF: CanTX(POWER_OFF, txData, 0, 5); break;
+				case SEND_DIAGNOSTICS: TransmitDiagnostics(); break;
+				case POWER_OFF:
+					SaveEnergyTotals();
+					EventLogFlush();
+					CanTX(POWER_OFF, txData, 0, 5);
+					break;
 			}
 			canToGo = NOTHING_TO_SEND;
 		}
 
+		if (isoTp.rxState == ISOTP_DONE) HandleIsoTpRequest();
+		if (configSync.active && configSync.received == CONFIG_SYNC_ALL) FinishConfigSync();
+		BmsPollUpdate();
+		PackSummaryUpdate();
+		DriftAnalysisStep();
+		EepromRingPoll(&energyRing);
+		EventLogUpdate();
+
 		// LCD update stuff - happens whenever there's free time
 		char oldCoreStatus = coreStatus;
 		coreStatus = evmsStatusBytes[0]&0x07; // Bottom 3 bits are status
-		if (oldCoreStatus != coreStatus) displayNeedsFullRedraw = true;
+		if (oldCoreStatus != coreStatus)
+		{
+			displayNeedsFullRedraw = true;
+			if (haveReceivedEVMSData)
+			{
+				if (oldCoreStatus == CHARGING) LogEvent(EVENT_CHARGE_END, StateOfCharge());
+				if (coreStatus == CHARGING)
+					LogEvent(EVENT_CHARGE_START, StateOfCharge());
+				else
+					LogEvent(EVENT_STATE, coreStatus);
+			}
+		}
 		
 		char newError = evmsStatusBytes[0]>>3; // Top 5 bytes hold error codes
 		if (error < CORE_COMMS_ERROR) SetError(newError); // Only update error with Core error status if a Monitor error isn't pending
@@ -676,15 +2236,29 @@ int main()
 			RenderBMSDetails();
 		else if (displayedPage == BMS_SUMMARY)
 			RenderBMSSummary();
+		else if (displayedPage == CELL_RESISTANCE)
+			RenderCellResistance();
+		else if (displayedPage == CELL_DRIFT)
+			RenderCellDrift();
+		else if (displayedPage == TRIP_COMPUTER)
+			RenderTripComputer();
+		else if (displayedPage == EVENT_LOG)
+			RenderEventLog();
+		else if (displayedPage == DIAGNOSTICS)
+			RenderDiagnostics();
+		else if (displayedPage == CAN_DIAGNOSTICS)
+			RenderCanDiagnostics();
+		else if (displayedPage == DATA_AGE)
+			RenderDataAge();
 
 		if (SHOW_TOUCH_LOCATION)
 		{
 			char temp[5];
 			itoa(touchX, buffer, 10);
-			strcat(buffer, ",");
+			strcat_P(buffer, PSTR(","));
 			itoa(touchY, temp, 10);
 			strcat(buffer, temp);
-			strcat(buffer, " ");
+			strcat_P(buffer, PSTR(" "));
 			
 			TFT_Text(buffer, 0, 0, 1, GREEN, BLACK);
 		}
@@ -765,6 +2339,12 @@ void HandleTouchDown()
 				CheckTouchedButton(&nextBmsModuleButton);
 				CheckTouchedButton(&prevBmsModuleButton);
 			}
+			if (displayedPage == TRIP_COMPUTER) CheckTouchedButton(&resetTripButton);
+			if (displayedPage == EVENT_LOG)
+			{
+				CheckTouchedButton(&olderEventsButton);
+				CheckTouchedButton(&newerEventsButton);
+			}
 
 			Beep(2);		
 		}
@@ -829,7 +2409,7 @@ void HandleTouchUp()
 			setupMode = true;
 			if (isBMS16)
 				for (int n=0; n<NUM_SETTINGS; n++)
-					if (settings[n] > bms16maximums[n]) settings[n] = bms16maximums[n]; // Cap to BMS16 maximums
+					if (settings[n] > pgm_read_byte(&bms16maximums[n])) settings[n] = pgm_read_byte(&bms16maximums[n]); // Cap to BMS16 maximums
 			showOptionsButtons = false;
 			displayNeedsFullRedraw = true;
 		}
@@ -876,10 +2456,22 @@ void HandleTouchUp()
 			char startModule = currentBmsModule;
 			do {
 				currentBmsModule--;
-				if (currentBmsModule < 0) currentBmsModule = 15;
+				if (currentBmsModule < 0) currentBmsModule = MAX_BMS_MODULES-1;
 				if (currentBmsModule == startModule) break; // No modules found, avoids infinite loop
 			} while (bmsCellCounts[currentBmsModule] == 0);
 		}
+		else if (displayedPage == TRIP_COMPUTER && ButtonTouched(&resetTripButton) && touchedButton == &resetTripButton)
+		{
+			resetTripRequested = true; // Main loop does it, along with saving
+		}
+		else if (displayedPage == EVENT_LOG && ButtonTouched(&olderEventsButton) && touchedButton == &olderEventsButton)
+		{
+			eventPage++; // The viewer steps back if there's nothing there
+		}
+		else if (displayedPage == EVENT_LOG && ButtonTouched(&newerEventsButton) && touchedButton == &newerEventsButton)
+		{
+			if (eventPage > 0) eventPage--;
+		}
 		else if (touchedButton == 0 && touchTimer < 30) // Wasn't a touch down in a button, and we're running/charging
 		{
 			char oldPage = displayedPage;
@@ -891,6 +2483,10 @@ void HandleTouchUp()
 				if (displayedPage == TC_CHARGER && !haveReceivedChargerData) displayedPage++;
 				if (displayedPage == BMS_SUMMARY && numCells == 0) displayedPage++;
 				if (displayedPage == BMS12_DETAILS && numCells == 0) displayedPage++;
+				if (displayedPage == CELL_RESISTANCE && (numCells == 0 || !haveReceivedCurrentData)) displayedPage++;
+				if (displayedPage == CELL_DRIFT && numCells == 0) displayedPage++;
+				if (displayedPage == TRIP_COMPUTER && !haveReceivedCurrentData) displayedPage++;
+				if (displayedPage >= DIAGNOSTICS && !SHOW_DIAGNOSTICS) displayedPage = NUM_KNOWN_DEVICES;
 				if (displayedPage == NUM_KNOWN_DEVICES) displayedPage = 0;
 				if (displayedPage == EVMS_CORE && !haveReceivedEVMSData) displayedPage++;
 			}
@@ -898,7 +2494,11 @@ void HandleTouchUp()
 			{
 				displayedPage--;
 				if (displayedPage == EVMS_CORE && !haveReceivedEVMSData) displayedPage--;
-				if (displayedPage < EVMS_CORE) displayedPage = BMS12_DETAILS; // Wrap around
+				if (displayedPage < EVMS_CORE) displayedPage = NUM_KNOWN_DEVICES-1; // Wrap around
+				if (displayedPage >= DIAGNOSTICS && !SHOW_DIAGNOSTICS) displayedPage = DIAGNOSTICS-1;
+				if (displayedPage == TRIP_COMPUTER && !haveReceivedCurrentData) displayedPage--;
+				if (displayedPage == CELL_DRIFT && numCells == 0) displayedPage--;
+				if (displayedPage == CELL_RESISTANCE && (numCells == 0 || !haveReceivedCurrentData)) displayedPage--;
 				if (displayedPage == BMS12_DETAILS && numCells == 0) displayedPage--;
 				if (displayedPage == BMS_SUMMARY && numCells == 0) displayedPage--; // Skip past BMS pages if no cells being monitored
 				if (displayedPage == TC_CHARGER && !haveReceivedChargerData) displayedPage--; // Skip if no charger
@@ -916,6 +2516,8 @@ void HandleTouchUp()
 
 void DoSetupButtons(char isKeyRepeat)
 {
+	STACK_PROBE();
+
 	// Always visible on Setup page are buttons to change (toggle) the settings page
 	if (ButtonTouched(&changeSetupPageButtonLeft))
 	{
@@ -938,7 +2540,7 @@ void DoSetupButtons(char isKeyRepeat)
 		{
 			currentParameter--;
 			if (isBMS16) // If we're connected to a BMS16, skip past nonapplicable parameters
-				while (bms16maximums[currentParameter] == 0) currentParameter--;
+				while (pgm_read_byte(&bms16maximums[currentParameter]) == 0) currentParameter--;
 
 			if (currentParameter < 0) currentParameter = NUM_SETTINGS-1;
 		}
@@ -947,7 +2549,7 @@ void DoSetupButtons(char isKeyRepeat)
 		{
 			currentParameter++;
 			if (isBMS16)
-				while (bms16maximums[currentParameter] == 0) currentParameter++;
+				while (pgm_read_byte(&bms16maximums[currentParameter]) == 0) currentParameter++;
 
 			if (currentParameter == NUM_SETTINGS) currentParameter = 0;	
 		}
@@ -989,14 +2591,14 @@ void DoSetupButtons(char isKeyRepeat)
 				delta = 0;
 			}
 
-			int maximum = maximums[currentParameter];
-			if (isBMS16) maximum = bms16maximums[currentParameter];
+			int minimum = pgm_read_byte(&minimums[currentParameter]);
+			int maximum = pgm_read_byte(&maximums[currentParameter]);
+			if (isBMS16) maximum = pgm_read_byte(&bms16maximums[currentParameter]);
 			if (isBMS16 && isActuallyBMS12i && currentParameter == NUM_CELLS)
 			{
-				minimums[NUM_CELLS] = 4; maximum = 12;
+				minimum = 4; maximum = 12;
 			}
-			settings[currentParameter] = Cap(settings[currentParameter]+delta,
-				minimums[currentParameter], maximum);
+			settings[currentParameter] = Cap(settings[currentParameter]+delta, minimum, maximum);
 
 			if (isBMS16 && currentParameter == SHUNT_SIZE && settings[currentParameter] > 3)
 				settings[currentParameter] = 3;
@@ -1024,23 +2626,22 @@ void DoSetupButtons(char isKeyRepeat)
 			int delta = 1;
 			if (ButtonTouched(&changeValueButtonLeft)) delta = -1;
 
-			if ((mcStatusBytes[0]&0x0F) == MC600C) // Need to change maximums for smaller controller
-			{
-				mcMaximums[MC_MAX_MOTOR_CURRENT] = 60;
-				mcMaximums[MC_MAX_BATT_CURRENT] = 60;
-			}
+			int maximum = pgm_read_byte(&mcMaximums[mcCurrentParameter]);
+			if ((mcStatusBytes[0]&0x0F) == MC600C // Lower current limits for the smaller controller
+				&& (mcCurrentParameter == MC_MAX_MOTOR_CURRENT || mcCurrentParameter == MC_MAX_BATT_CURRENT))
+				maximum = 60;
 
 			mcSettings[mcCurrentParameter] = Cap(mcSettings[mcCurrentParameter]+delta,
-				mcMinimums[mcCurrentParameter], mcMaximums[mcCurrentParameter]);
+				pgm_read_byte(&mcMinimums[mcCurrentParameter]), maximum);
 		}
 	}
 	else if (settingsPage == PACK_SETUP) // Pack setup.. 16 buttons for selecting cell, 13 buttons for selecting number of cells
 	{
 		if (ButtonTouched(&changeParameterButtonRight))
-			currentBmsModule = Cap(currentBmsModule+1, 0, 15);
+			currentBmsModule = Cap(currentBmsModule+1, 0, MAX_BMS_MODULES-1);
 
 		if (ButtonTouched(&changeParameterButtonLeft))
-			currentBmsModule = Cap(currentBmsModule-1, 0, 15);
+			currentBmsModule = Cap(currentBmsModule-1, 0, MAX_BMS_MODULES-1);
 		
 		if (ButtonTouched(&changeValueButtonLeft)) // Reduce by 1
 		{
@@ -1062,31 +2663,54 @@ void DoSetupButtons(char isKeyRepeat)
 	}
 }
 
+// Core settings, then expected BMS cell counts packed two to a byte. The Core only knows about the first 16 modules
+static void PackCoreConfig(U8* image)
+{
+	memcpy(image, settings, CORE_CONFIG_SETTINGS);
+	for (int n=0; n<8; n++) image[CORE_CONFIG_SETTINGS+n] = bmsCellCounts[n*2] | bmsCellCounts[n*2+1]<<4;
+}
+
+// Sends the given blocks of coreConfig. Cell counts go first and CONFIG4 always goes last,
+// as the Core saves to EEPROM only after receiving it
+static void SendCoreConfig(U8 blocks)
+{
+	if (!blocks) return;
+	blocks |= 1<<3;
+	if (blocks & 1<<4) CanTX(CORE_RECEIVE_CELL_NUMS, &coreConfig[CORE_CONFIG_SETTINGS], 8, 20);
+	for (int b=0; b<4; b++)
+		if (blocks & 1<<b) CanTX(CORE_RECEIVE_CONFIG1+b, &coreConfig[b*8], 8, 20);
+}
+
+static void RequestMcSettings()
+{
+	txData[0] = 0;
+	configSync.mcWait = MC_SETTINGS_TIMEOUT;
+	CanTX(MC_RECEIVE_SETTINGS_ID, txData, 1, 0);
+}
+
 void TransmitSettings()
 {
-	// Pack and send expected BMS cell counts		
-	for (int n=0; n<8; n++)
-	{
-		txData[n] = bmsCellCounts[n*2];
-		txData[n] += bmsCellCounts[n*2+1]<<4;
-	}
-	
-	CanTX(CORE_RECEIVE_CELL_NUMS, txData, 8, 20);
-	// Pack and send updated core settings
-	for (int n=0; n<8; n++) txData[n] = settings[n];
-	CanTX(CORE_RECEIVE_CONFIG1, txData, 8, 20);
-	for (int n=0; n<8; n++) txData[n] = settings[n+8];
-	CanTX(CORE_RECEIVE_CONFIG2, txData, 8, 20);
-	for (int n=0; n<8; n++) txData[n] = settings[n+16];
-	CanTX(CORE_RECEIVE_CONFIG3, txData, 8, 20);
-	for (int n=0; n<8; n++) txData[n] = settings[n+24];
-	CanTX(CORE_RECEIVE_CONFIG4, txData, 8, 20); // -> Remember, Core saves to EEPROM only after receiving this packet
+	// Only send blocks that differ from what the Core last confirmed, or everything if we don't know
+	U8 image[CONFIG_SYNC_BLOCKS*8];
+	U8 dirty = CONFIG_SYNC_ALL;
+	PackCoreConfig(image);
+	if (coreConfigKnown)
+		for (int b=0; b<CONFIG_SYNC_BLOCKS; b++)
+			if (memcmp(&image[b*8], &coreConfig[b*8], 8) == 0) dirty &= ~(1<<b);
+	configSync.active = false; // A sync still running from entering setup would undo the changes
+	memcpy(coreConfig, image, sizeof(image)); // What we expect to read back
+	SendCoreConfig(dirty);
 	
-	// Send motor controller settings
-	for (int n=0; n<4; n++) txData[n] = mcSettings[n];
+	// Same for the motor controller settings
 	txData[4] = mcSettings[MC_RAMP_RATE] + (mcSettings[MC_SPEED_CONTROL_TYPE]<<4) + (mcSettings[MC_TORQUE_CONTROL_TYPE]<<6);
+	for (int n=0; n<4; n++) txData[n] = mcSettings[n];
 	for (int n=5; n<8; n++) txData[n] = mcSettings[n+2];
-	CanTX(MC_RECEIVE_SETTINGS_ID, txData, 8, 20);
+	configSync.askMc = !mcConfigKnown || memcmp(txData, mcConfig, 8) != 0;
+	if (configSync.askMc)
+	{
+		configSync.mcWait = MC_SETTINGS_TIMEOUT;
+		CanTX(MC_RECEIVE_SETTINGS_ID, txData, 8, 20);
+	}
 
 	if (isBMS16)
 	{
@@ -1108,9 +2732,119 @@ void TransmitSettings()
 
 	CalculateNumCells(); // In case it has changed
 
+	if (settings[CAN_SPEED] != canSpeedSetting) // Only now the Core has everything. Nothing can be read back at the old speed
+	{
+		coreConfigKnown = mcConfigKnown = false;
+		CanRestart(CAN_BUS_OK);
+	}
+	else if (dirty) StartConfigSync(true); // Otherwise ConfigSyncTimeouts() asks the motor controller if need be
+
 	//wdt_enable(WDTO_500MS);
 }
 
+void StartConfigSync(bool verify)
+{
+	configSync.verifying = verify;
+	configSync.received = 0;
+	configSync.triesLeft = CONFIG_SYNC_TRIES;
+	configSync.timer = 0; // Ask straight away
+	configSync.active = true;
+}
+
+// Ends the sync whether or not we heard back. Entering setup or reading back carries on from ConfigSyncTimeouts()
+static void EndConfigSync(bool confirmed)
+{
+	configSync.active = false;
+	coreConfigKnown = confirmed; // If not, everything gets sent next time
+	if (setupMode) configSync.askMc = true;
+}
+
+// Called at 4Hz
+void ConfigSyncTimeouts()
+{
+	if (configSync.quiet > 0) configSync.quiet--;
+	if (!configSync.active && configSync.askMc && configSync.quiet == 0) // Its answer can't be mistaken for a late block now
+	{
+		configSync.askMc = false;
+		RequestMcSettings();
+	}
+	if (configSync.mcWait > 0) // Its answer could be taken for one of the Core's blocks, so hold off till it's in
+	{
+		configSync.mcWait--;
+		return;
+	}
+	if (!configSync.active || configSync.timer-- > 0) return;
+
+	// CORE_REQUEST_CONFIG is the motor controller's throttle ID, so with one on the bus we don't ask
+	if (configSync.triesLeft == 0 || haveReceivedMCData) // No Core, or one that doesn't answer, so keep what we have
+	{
+		EndConfigSync(false);
+		return;
+	}
+	configSync.triesLeft--;
+	configSync.timer = CONFIG_SYNC_TIMEOUT;
+	configSync.seen = 0;
+	configSync.quiet = CONFIG_SYNC_TIMEOUT;
+	CanTX(CORE_REQUEST_CONFIG, txData, 0, 0); // Blocks already received are kept if only some come back
+}
+
+// All blocks are in. When verifying, anything the Core didn't take is sent again and read back,
+// out of the same tries. Otherwise the Core's copy wins, and EEPROM is only written if it was any different
+void FinishConfigSync()
+{
+	if (configSync.verifying)
+	{
+		U8 wrong = 0;
+		for (int b=0; b<CONFIG_SYNC_BLOCKS; b++)
+			if (memcmp(&configSync.data[b*8], &coreConfig[b*8], 8) != 0) wrong |= 1<<b;
+		if (wrong && configSync.triesLeft > 0)
+		{
+			SendCoreConfig(wrong);
+			configSync.received = 0;
+			configSync.timer = 0; // Read back again on the next tick
+		}
+		else EndConfigSync(!wrong);
+		return;
+	}
+
+	// Only adopt what the setup pages could have set, so a stray frame can't end up in EEPROM
+	bool valid = true;
+	for (int n=0; n<CORE_CONFIG_SETTINGS; n++)
+		if (configSync.data[n] < pgm_read_byte(&minimums[n]) || configSync.data[n] > pgm_read_byte(&maximums[n])) valid = false;
+	for (int n=0; n<8; n++)
+		if ((configSync.data[CORE_CONFIG_SETTINGS+n] & 0x0F) > CELLS_PER_MODULE || configSync.data[CORE_CONFIG_SETTINGS+n] >> 4 > CELLS_PER_MODULE)
+			valid = false;
+	if (!valid)
+	{
+		cli();
+		configSync.received = 0;
+		sei();
+		if (configSync.triesLeft > 0) configSync.timer = 0; // Ask again on the next tick
+		else EndConfigSync(false);
+		return;
+	}
+
+	bool matches = memcmp(configSync.data, settings, CORE_CONFIG_SETTINGS) == 0;
+	for (int n=0; n<8; n++)
+		if (configSync.data[CORE_CONFIG_SETTINGS+n] != (bmsCellCounts[n*2] | bmsCellCounts[n*2+1]<<4)) matches = false;
+
+	if (!matches)
+	{
+		memcpy(settings, configSync.data, CORE_CONFIG_SETTINGS);
+		for (int n=0; n<8; n++)
+		{
+			bmsCellCounts[n*2] = configSync.data[CORE_CONFIG_SETTINGS+n] & 0x0F;
+			bmsCellCounts[n*2+1] = configSync.data[CORE_CONFIG_SETTINGS+n] >> 4;
+		}
+		SaveSettingsToEEPROM();
+		CalculateNumCells();
+		displayNeedsFullRedraw = true;
+	}
+
+	memcpy(coreConfig, configSync.data, sizeof(coreConfig));
+	EndConfigSync(true);
+}
+
 void TransmitGaugeState()
 {
 	if (settingsPage == GENERAL_SETTINGS)
@@ -1139,6 +2873,117 @@ void TransmitGaugeState()
 	}
 }
 
+// Stack never used, then deepest stack seen in the main loop, TIMER0 and TIMER1 ISRs, all in bytes
+void TransmitDiagnostics()
+{
+	U16 values[4];
+	values[0] = StackNeverUsed();
+	cli(); // Depths are updated by the ISRs
+	for (int n=0; n<STACK_NUM_CONTEXTS; n++) values[n+1] = stackMaxDepth[n];
+	sei();
+
+	for (int n=0; n<4; n++)
+	{
+		txData[n*2] = values[n]>>8;
+		txData[n*2+1] = values[n]&0xFF;
+	}
+	CanTX(MONITOR_DIAGNOSTICS_REPLY, txData, 8, 0);
+}
+
+void HandleIsoTpRequest()
+{
+	if (isoTp.txState == ISOTP_BUSY) return; // Still sending the last reply, so the request waits
+
+	U8 request[sizeof(isoTpRequest)]; // The buffer's free for the next one once released
+	memcpy(request, isoTpRequest, sizeof(request));
+	U16 requestLength = isoTp.rxLength;
+	U8 service = request[0];
+	IsoTpRelease(&isoTp);
+
+	U16 length = 0;
+	isoTpReply[length++] = service | ISOTP_POSITIVE_REPLY;
+	switch (service)
+	{
+		case ISOTP_READ_SETTINGS:
+			memcpy(&isoTpReply[length], settings, NUM_SETTINGS);
+			length += NUM_SETTINGS;
+			memcpy(&isoTpReply[length], bmsCellCounts, MAX_BMS_MODULES);
+			length += MAX_BMS_MODULES;
+			memcpy(&isoTpReply[length], mcSettings, MC_NUM_SETTINGS);
+			length += MC_NUM_SETTINGS;
+			break;
+
+		case ISOTP_READ_DIAGNOSTICS: // Little endian, straight out of memory
+		{
+			U16 neverUsed = StackNeverUsed();
+			memcpy(&isoTpReply[length], &neverUsed, 2);
+			length += 2;
+			cli(); // All updated by the ISRs
+			memcpy(&isoTpReply[length], (const void*)stackMaxDepth, sizeof(stackMaxDepth));
+			length += sizeof(stackMaxDepth);
+			memcpy(&isoTpReply[length], &canStats, sizeof(CanStats));
+			length += sizeof(CanStats);
+			memcpy(&isoTpReply[length], (const void*)&canSupervisor, sizeof(CanSupervisor));
+			length += sizeof(CanSupervisor);
+			sei();
+			break;
+		}
+
+		case ISOTP_READ_BLACK_BOX: // Request has the first frame wanted, 0 being the oldest
+		{
+			if (requestLength < 2)
+			{
+				isoTpReply[0] = ISOTP_NEGATIVE_REPLY;
+				isoTpReply[length++] = service;
+				break;
+			}
+			cli();
+			U8 first = request[1];
+			U8 count = blackBox.count;
+			isoTpReply[length++] = blackBox.frozen;
+			isoTpReply[length++] = blackBox.trigger;
+			isoTpReply[length++] = blackBox.frozenAt>>8;
+			isoTpReply[length++] = blackBox.frozenAt;
+			isoTpReply[length++] = count;
+			isoTpReply[length++] = first;
+			U8 index = blackBox.head + BLACK_BOX_FRAMES - count + first; // Oldest is count back from head
+			for (U8 n=0; n<BLACK_BOX_PER_READ && first+n < count; n++, index++)
+			{
+				BlackBoxFrame* f = &blackBox.frames[index % BLACK_BOX_FRAMES];
+				for (S8 shift=24; shift>=0; shift-=8) isoTpReply[length++] = f->id>>shift;
+				isoTpReply[length++] = f->stamp>>8;
+				isoTpReply[length++] = f->stamp;
+				isoTpReply[length++] = f->length;
+				memcpy(&isoTpReply[length], f->data, 8);
+				length += 8;
+			}
+			sei();
+			break;
+		}
+
+		case ISOTP_ARM_BLACK_BOX: // Optionally followed by match and mask (big endian) and exclude
+		{
+			cli();
+			if (requestLength >= 10)
+			{
+				blackBox.match = ((U32)request[1]<<24) | ((U32)request[2]<<16) | ((U16)request[3]<<8) | request[4];
+				blackBox.mask = ((U32)request[5]<<24) | ((U32)request[6]<<16) | ((U16)request[7]<<8) | request[8];
+				blackBox.exclude = request[9];
+			}
+			blackBox.head = blackBox.count = 0;
+			blackBox.frozen = false;
+			sei();
+			break;
+		}
+
+		default:
+			isoTpReply[0] = ISOTP_NEGATIVE_REPLY;
+			isoTpReply[length++] = service;
+	}
+
+	IsoTpSend(&isoTp, isoTpReply, length);
+}
+
 void Beep(short ticks)
 {
 	if (settings[BUZZER_ON])
@@ -1164,76 +3009,27 @@ void UpdateBuzzer()
 	}
 }
 
-void AddDecimalPoint(char* buffer) // (to a number stored as a string)
-{
-	short i = strlen(buffer);
-	if (i == 1) // i.e single character, we want to add a leading zero
-	{	
-		buffer[2] = 0;
-		buffer[1] = buffer[0];
-		buffer[0] = '0';
-		i++;
-	}
-
-	buffer[i+1] = buffer[i]; // move final zero
-	buffer[i] = buffer[i-1]; // move last character
-	buffer[i-1] = '.'; // insert decimal
-}
-
-void AddDecimalPoint2(char* buffer) // (to a number stored in a string, to 2 decimal places)
-{
-	char temp[10];
-	while (strlen(buffer) < 3) // Add leading zeroes until we have at least 3 digits
-	{
-		strcpy(temp, "0");
-		strcat(temp, buffer);
-		strcpy(buffer, temp);
-	}
-
-	short i = strlen(buffer);
-	buffer[i+1] = buffer[i]; // move final zero
-	buffer[i] = buffer[i-1]; // move last character
-	buffer[i-1] = buffer[i-2]; // move 2nd last character
-	buffer[i-2] = '.'; // insert decimal
-}
-
-void AddDecimalPoint3(char* buffer) // (to a number stored in a string, to 3 decimal places)
-{
-	char temp[10];
-	while (strlen(buffer) < 4) // Add leading zeroes until we have at least 4 digits
-	{
-		strcpy(temp, "0");
-		strcat(temp, buffer);
-		strcpy(buffer, temp);
-	}
-
-	short i = strlen(buffer);
-	buffer[i+1] = buffer[i]; // move final zero
-	buffer[i] = buffer[i-1]; // move last character
-	buffer[i-1] = buffer[i-2]; // move 2nd last character
-	buffer[i-2] = buffer[i-3]; // move 3rd last character
-	buffer[i-3] = '.'; // insert decimal
-}
-
-void WriteTemp(char* buffer, short celcius)
+// Temperature in the user's choice of units, as a fixed width field (see TFT_Number)
+void DrawTemp(short celcius, unsigned char width, unsigned int x, unsigned int y, char scale, U16 Fcolor, U16 Bcolor)
 {
 	if (settings[USE_FAHRENHEIT])
-	{
-		itoa(celcius*9/5+32, buffer, 10);
-		strcat(buffer, "~F "); // ~ has been modified to display the degree sign
-	}
+		TFT_Number(celcius*9/5+32, 0, 0, width, ALIGN_LEFT, PSTR("~F"), x, y, scale, Fcolor, Bcolor); // ~ has been modified to display the degree sign
 	else
-	{
-		itoa(celcius, buffer, 10);
-		strcat(buffer, "~C ");
-	}
+		TFT_Number(celcius, 0, 0, width, ALIGN_LEFT, PSTR("~C"), x, y, scale, Fcolor, Bcolor);
 }
 
 void CanTX(long packetID, unsigned char* data, unsigned char length, unsigned char delayAfterSending)
 {
+	if (canSupervisor.state == CAN_BUS_OFF) // It would never go, the supervisor will restart the controller soon
+	{
+		canStats.txErrors++;
+		return;
+	}
+
 	canTXing = true; // Semaphor so it doesn't RX while TXing
 	
 	st_cmd_t canFrame;
+	STACK_PROBE();
 	canFrame.pt_data = data;
 	if (USE_29BIT_IDS)
 	{
@@ -1248,7 +3044,25 @@ void CanTX(long packetID, unsigned char* data, unsigned char length, unsigned ch
 	canFrame.dlc = length;
 	canFrame.cmd = CMD_TX_DATA;
 	while (can_cmd(&canFrame) != CAN_CMD_ACCEPTED) {} // Wait for MOB to accept frame
-	while (can_get_status(&canFrame) == CAN_STATUS_NOT_COMPLETED) {} // Wait for TX completion
+	U8 status;
+	while ((status = can_get_status(&canFrame)) == CAN_STATUS_NOT_COMPLETED) // Wait for TX completion
+	{
+		if (CANGSTA & (1<<BOFF)) // Went bus off trying, so it's not going to complete
+		{
+			canFrame.cmd = CMD_ABORT;
+			can_cmd(&canFrame);
+			status = CAN_STATUS_ERROR;
+			break;
+		}
+	}
+
+	canStats.txFrames++;
+	canStats.bits += (canFrame.ctrl.ide ? CAN_EXT_FRAME_BITS : CAN_STD_FRAME_BITS) + length*10;
+	if (status == CAN_STATUS_ERROR)
+	{
+		canStats.txErrors++;
+		CountMobErrors(canFrame.status);
+	}
 
 	if (delayAfterSending > 0) _delay_ms(delayAfterSending);
 
@@ -1348,29 +3162,67 @@ void SaveSettingsToEEPROM()
 }
 
 // Functions for writing to display
-void DrawTitlebar(char* text)
+static U16 TitlebarColour()
 {
-	U16 col = L_GRAY;
+	if (settings[STATIONARY_VERSION] && (error == BMS_HIGH_WARNING || error == BMS_LOW_WARNING)) return RED;
 	switch (coreStatus)
 	{
-		case PRECHARGING:	col = ORANGE; break;
-		case RUNNING:		col = L_GRAY; break;
-		case CHARGING:		col = CHARGING_COLOUR; break;
-		case STOPPED:		col = RED; break;
-		case SETUP:			col = L_GRAY; break;
+		case PRECHARGING:	return ORANGE;
+		case CHARGING:		return CHARGING_COLOUR;
+		case STOPPED:		return RED;
 	}
+	return L_GRAY;
+}
+
+void DrawTitlebar(char* text)
+{
+	U16 col = TitlebarColour();
 	if (settings[STATIONARY_VERSION] && (error == BMS_HIGH_WARNING || error == BMS_LOW_WARNING))
 	{
-		col = RED;
-		if (displayedPage != BMS12_DETAILS && error == BMS_HIGH_WARNING)
-			text = "EVMS : Charge Disabled";
-		else if (displayedPage != BMS12_DETAILS && error == BMS_LOW_WARNING)
-			text = "EVMS : Discharge Disabled";
+		if (displayedPage != BMS12_DETAILS && error == BMS_HIGH_WARNING)
+		{
+			strcpy_P(buffer, PSTR("EVMS : Charge Disabled"));
+			text = buffer;
+		}
+		else if (displayedPage != BMS12_DETAILS && error == BMS_LOW_WARNING)
+		{
+			strcpy_P(buffer, PSTR("EVMS : Discharge Disabled"));
+			text = buffer;
+		}
+	}
+
+	TFT_Fill(BGND_COLOUR);
+	memset(cellBarCache, BAR_CACHE_INVALID, sizeof(cellBarCache)); // Screen's been cleared, so all bars need drawing
+	TFT_Box(0, 0, 319, 19, col);
+	TFT_CentredPropText(text, 160, 2, TEXT_COLOUR, col);
+
+	// State icon for the device this page shows, on the title bar's colour
+	const unsigned char* icon = 0;
+	if (!setupMode)
+	{
+		switch (displayedPage)
+		{
+			case MOTOR_CONTROLLER:	icon = SPRITE_MOTOR; break;
+			case TC_CHARGER:		icon = SPRITE_CHARGER; break;
+			case BMS_SUMMARY:
+			case BMS12_DETAILS:		icon = SPRITE_BMS; break;
+		}
+	}
+	if (icon)
+	{
+		unsigned int palette[3];
+		TFT_SpritePalette(icon, palette);
+		palette[0] = col;
+		if (col == CHARGING_COLOUR) palette[2] = DARK_GRAY; // Green accent would vanish on the charging title bar
+		TFT_Sprite(icon, 4, 2, palette);
 	}
+}
 
-	TFT_Fill(BGND_COLOUR);
-	TFT_Box(0, 0, 319, 19, col);
-	TFT_CentredText(text, 160, 2, 1, TEXT_COLOUR, col);
+// Same, for titles stored in flash
+void DrawTitlebar_P(const char* text)
+{
+	strcpy_P(buffer, text);
+	DrawTitlebar(buffer);
 }
 
 void RenderStartupScreen()
@@ -1378,17 +3230,45 @@ void RenderStartupScreen()
 	if (displayNeedsFullRedraw) TFT_Fill(BGND_COLOUR);
 	displayNeedsFullRedraw = false;
 
-	TFT_Box(0, 60, 57, 120, D_GRAY); // left
+	// Band around the title, which fills x = 52 to 267, y = 66 to 113 itself
 	TFT_Box(0, 60, 319, 65, D_GRAY); // top
-	TFT_Box(273, 60, 319, 120, D_GRAY); // right
 	TFT_Box(0, 114, 319, 120, D_GRAY); // bottom
+	TFT_Box(0, 66, 51, 113, D_GRAY); // left
+	TFT_Box(268, 66, 319, 113, D_GRAY); // right
 	//for (int x=0; x<320; x+=2) TFT_Box(x, 60, x, 120, D_GRAY);
-	TFT_CentredText("FZR250", 160, 66, 3, LABEL_COLOUR, D_GRAY);
-	TFT_CentredText("ZEVA EVMS v3", 160, 145, 1, L_GRAY, BGND_COLOUR);
+	TFT_CentredLargeText_P(PSTR("FZR250"), 160, 66, 3, LABEL_COLOUR, D_GRAY);
+	TFT_CentredText_P(PSTR("ZEVA EVMS v3"), 160, 145, 1, L_GRAY, BGND_COLOUR);
+}
+
+// Minutes until empty, or until full while charging, or -1 if there's nothing to go on (or it's over 99
+// hours). Each average gives its own estimate, and we go with the longest one whose estimate is at least
+// 16 of its time constants away, so a long way out isn't thrown around by every hill, and near empty
+// follows what's happening now
+static int TimeRemaining()
+{
+	if (!consumptionSeeded || IsStale(SOURCE_CORE) || IsStale(SOURCE_CURRENT)) return -1;
+	long ampHours = (evmsStatusBytes[1]<<8) + evmsStatusBytes[2]; // 0.1Ah left
+	bool charging = (coreStatus == CHARGING);
+	long toGo = charging ? (long)settings[PACK_CAPACITY]*PACK_CAPACITY_MULTIPLIER*10 - ampHours : ampHours;
+	if (toGo <= 0) return 0;
+
+	for (signed char k=CONSUMPTION_AVERAGES-1; k>=0; k--)
+	{
+		cli(); // Averages are updated by the RX poll
+		long rate = consumption[k];
+		sei();
+		if (charging) rate = -rate;
+		if (rate < CONSUMPTION_MIN_RATE) return -1; // Not emptying (or filling) at any useful rate
+		long minutes = toGo*6000/rate; // 0.1Ah/mA in hours is 100, so 6000 in minutes
+		if (k == 0 || minutes >= (16L << (CONSUMPTION_MIN_SHIFT + k*CONSUMPTION_SHIFT_STEP))/60000)
+			return (minutes > 99*60+59) ? -1 : minutes;
+	}
+	return -1;
 }
 
 void RenderMainView()
 {
+	static int shownMinutes;
 	int temperature = evmsStatusBytes[7];
 	int voltage = (evmsStatusBytes[3]<<8) + evmsStatusBytes[4];
 	int isolation = evmsStatusBytes[6] & 0b01111111; // Bottom 7 bits only
@@ -1400,31 +3280,50 @@ void RenderMainView()
 		char statusText[20];
 		strcpy_P(statusText, (char*)pgm_read_word(&(coreStatuses[coreStatus])));
 		if (isBMS16)
-			strcpy(buffer, "BMS Status : ");
+			strcpy_P(buffer, PSTR("BMS Status : "));
 		else
-			strcpy(buffer, "FZR250 : ");
+			strcpy_P(buffer, PSTR("FZR250 : "));
 		strcat(buffer, statusText);
 		
 		DrawTitlebar(buffer);
 		
-		TFT_Text("Voltage", 16, 30, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Voltage"), 16, 30, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_Text("Current", 16, 88, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Power", 16, 146, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Current"), 16, 88, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Power"), 16, 146, LABEL_COLOUR, BGND_COLOUR);
 
 		if (isBMS16)
 		{	// Used to only show temp if a sensor was plugged in, but I think it looks better to show title always and '-' value
-			/*if (evmsStatusBytes[7] > 0)*/ TFT_Text("Temp", 16, 202, 1, LABEL_COLOUR, BGND_COLOUR);
+			/*if (evmsStatusBytes[7] > 0)*/ TFT_PropText_P(PSTR("Temp"), 16, 202, LABEL_COLOUR, BGND_COLOUR);
 		}
 		else
-			TFT_Text("Aux", 16, 202, 1, LABEL_COLOUR, BGND_COLOUR);
-		if (temperature > 0 && !isBMS16) TFT_Text("Temp", 100, 202, 1, LABEL_COLOUR, BGND_COLOUR);
-		if (isolation <= 100 && !isBMS16) TFT_Text("Isol", 172, 202, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("SoC", 244, 202, 1, LABEL_COLOUR, BGND_COLOUR);		
+			TFT_PropText_P(PSTR("Aux"), 16, 202, LABEL_COLOUR, BGND_COLOUR);
+		if (temperature > 0 && !isBMS16) TFT_PropText_P(PSTR("Temp"), 100, 202, LABEL_COLOUR, BGND_COLOUR);
+		if (isolation <= 100 && !isBMS16) TFT_PropText_P(PSTR("Isol"), 172, 202, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("SoC"), 244, 202, LABEL_COLOUR, BGND_COLOUR);		
+
+		unsigned int batteryPalette[3] = { BGND_COLOUR, L_GRAY, D_GRAY };
+		TFT_Sprite(SPRITE_BATTERY, 222, 36, batteryPalette); // Outline with an empty (D_GRAY) inside
+		socBarHeight = -1;
+		shownMinutes = -2; // Nothing shown yet
+	}
 
-		TFT_Box(243, 36, 279, 48, L_GRAY);
-		TFT_Box(245, 38, 277, 46, D_GRAY);
-		TFT_Box(222, 46, 300, 192, L_GRAY);
+	// Time to empty (or full, while charging) at the right of the title bar, as 1h23
+	int minutes = TimeRemaining();
+	if (minutes != shownMinutes)
+	{
+		shownMinutes = minutes;
+		char text[8];
+		text[0] = 0;
+		if (minutes >= 0)
+		{
+			itoa(minutes/60, text, 10);
+			strcat_P(text, (minutes%60 < 10) ? PSTR("h0") : PSTR("h"));
+			itoa(minutes%60, text+strlen(text), 10);
+		}
+		strcpy_P(buffer, PSTR("     "));
+		strcpy(buffer+5-strlen(text), text); // Right aligned
+		TFT_Text(buffer, 256, 2, 1, TEXT_COLOUR, TitlebarColour());
 	}
 
 	// Dynamic parts
@@ -1433,106 +3332,56 @@ void RenderMainView()
 	power = power/10000L; // Gets it into tenths of a kilowatt
 
 	if (voltage == 0)
-		strcpy(buffer, " -    ");
+		TFT_LargeText_P(PSTR(" -    "), 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
+	else if (voltage < 1000 && numCells > 0)
+		TFT_Number(voltage, 0, 1, 7, ALIGN_LEFT, PSTR("V"), 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-	{
-		if (voltage < 1000 && numCells > 0)
-		{
-			itoa(voltage, buffer, 10);
-			AddDecimalPoint(buffer);
-		}
-		else
-			itoa(voltage/10, buffer, 10);
-	
-		strcat(buffer, "V  ");
-	}
-	TFT_Text(buffer, 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(voltage, 1, 0, 7, ALIGN_LEFT, PSTR("V"), 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
 
 	int currenty = (current+50L)/100L; // round to 0.1A resolution 16 bit
 
 	if (settings[REVERSE_CURRENT_DISPLAY]) currenty = -currenty;
 
-	if (currentSensorTimeout == 0 && !isBMS16)
-		strcpy(buffer, " -    ");
+	if (IsStale(SOURCE_CURRENT) && !isBMS16)
+		TFT_LargeText_P(PSTR(" -    "), 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
+	else if (Abs(currenty) < 1000)
+		TFT_Number(currenty, 0, 1, 7, ALIGN_LEFT, PSTR("A"), 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-	{
-		if (Abs(currenty) < 1000)
-		{
-			itoa(currenty, buffer, 10);
-			AddDecimalPoint(buffer);
-		}
-		else
-			itoa(currenty/10, buffer, 10);
-
-		strcat(buffer, "A  ");
-	}
-	TFT_Text(buffer, 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(currenty, 1, 0, 7, ALIGN_LEFT, PSTR("A"), 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
 
-	if (currentSensorTimeout == 0 && !isBMS16)
-		strcpy(buffer, " -    ");
-	else
-	{
-		if (power < 1000) // Under 100kW
-		{
-			itoa(Abs(power), buffer, 10);
-			AddDecimalPoint(buffer); // Display in tenths of a kilowatt
-		}
-		else
-			itoa(Abs(power/10), buffer, 10); // Display whole kilowatts only
-		strcat(buffer, "kW ");
-	}
-	TFT_Text(buffer, 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+	if (IsStale(SOURCE_CURRENT) && !isBMS16)
+		TFT_LargeText_P(PSTR(" -    "), 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+	else if (power < 1000) // Under 100kW, display in tenths of a kilowatt
+		TFT_Number(power, 0, 1, 7, ALIGN_LEFT, PSTR("kW"), 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+	else // Display whole kilowatts only
+		TFT_Number(power, 1, 0, 7, ALIGN_LEFT, PSTR("kW"), 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
 
-	if (!isBMS16)
-	{
-		int auxV = evmsStatusBytes[5];
-		itoa(auxV, buffer, 10); // Aux voltage
-		AddDecimalPoint(buffer);
-		strcat(buffer, "V  ");
-		TFT_Text(buffer, 16, 220, 1, TEXT_COLOUR, BGND_COLOUR);
-	}
+	if (!isBMS16) TFT_Number(evmsStatusBytes[5], 0, 1, 6, ALIGN_LEFT, PSTR("V"), 16, 220, 1, TEXT_COLOUR, BGND_COLOUR); // Aux voltage
 
 	if (temperature > 0)
-	{
-		WriteTemp(buffer, temperature-40);
-		TFT_Text(buffer, 100-84*isBMS16, 220, 1, TEXT_COLOUR, BGND_COLOUR);
-	}
+		DrawTemp(temperature-40, 5, 100-84*isBMS16, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 	else if (isBMS16) // Always showing Temp label for BMS16, but '-' if no temp available (evens up GUI appearance)
-		TFT_Text(" -  ", 16, 220, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Text_P(PSTR(" -  "), 16, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 	
 	if (isolation <= 100 && !isBMS16)
 	{
-		int isol = ((isolation+5)/10)*10; // Do some rounding to nearest 10% so it doesn't jiggle too much
-		
-		itoa(isol, buffer, 10); // Leakage
-		strcat(buffer, "%  ");
-		TFT_Text(buffer, 172, 220, 1, TEXT_COLOUR, BGND_COLOUR);
+		// Leakage, rounded to the nearest 10% so it doesn't jiggle too much
+		TFT_Number((isolation+5)/10*10, 0, 0, 5, ALIGN_LEFT, PSTR("%"), 172, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 	}
 	
 	int ampHours = (evmsStatusBytes[1]<<8) + evmsStatusBytes[2];
 
-	int soc = Cap(201L*(long)ampHours/2L/(long)(settings[PACK_CAPACITY]*PACK_CAPACITY_MULTIPLIER*10), 0, 100); // 201L/2L is for rounding instead of truncating
+	int soc = StateOfCharge();
 
 	if (settings[SOC_DISPLAY] == SOC_AMPHOURS)
 	{
 		if (ampHours < 100)
-		{
-			itoa(ampHours, buffer, 10);
-			AddDecimalPoint(buffer);
-			strcat(buffer, "Ah ");
-		}
+			TFT_Number(ampHours, 0, 1, 6, ALIGN_LEFT, PSTR("Ah"), 244, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 		else
-		{
-			itoa((ampHours+5)/10, buffer, 10);
-			strcat(buffer, "Ah ");
-		}
+			TFT_Number(ampHours, 1, 0, 6, ALIGN_LEFT, PSTR("Ah"), 244, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 	}
 	else
-	{	
-		itoa(soc, buffer, 10);
-		strcat(buffer, "%  ");
-	}
-	TFT_Text(buffer, 244, 220, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(soc, 0, 0, 6, ALIGN_LEFT, PSTR("%"), 244, 220, 1, TEXT_COLOUR, BGND_COLOUR);
 
 	// Draw SoC as large battery icon
 	int height = 142 * soc / 100;
@@ -1540,12 +3389,36 @@ void RenderMainView()
 	if (soc < 40) colour = ORANGE;
 	else if (soc < 20) colour = RED;
 
-	TFT_Box(224, 48, 298, 190-height, D_GRAY);	// Background part
-	TFT_Box(224, 190-height, 298, 190, colour);	// SoC part
+	// Only repaint the rows that have changed. The SoC part covers rows 190-height to 190.
+	if (colour != socBarColour && socBarHeight >= 0)
+	{
+		if (socBarHeight > height) TFT_Box(224, 190-socBarHeight, 298, 189-height, D_GRAY);
+		socBarHeight = -1; // Repaint the whole SoC part in the new colour
+	}
+	if (height > socBarHeight)
+		TFT_Box(224, 190-height, 298, 189-socBarHeight, colour);	// SoC part
+	else if (height < socBarHeight)
+		TFT_Box(224, 190-socBarHeight, 298, 189-height, D_GRAY);	// Background part
+	socBarHeight = height;
+	socBarColour = colour;
+}
+
+// Dotted guide line across one bar of the cell graph, if row y is within the repainted rows top to bottom
+static void DrawBarGuide(int start, int end, int y, int top, int bottom)
+{
+	if (y < top || y > bottom) return;
+	for (int a=start/3; a<=end/3; a++) TFT_H_Line(a*3+1, a*3+1, y, WHITE);
 }
 
 void DrawCellsBarGraph()
 {
+	if (numCells != cellBarCount) // Bar widths have changed, so everything needs drawing from scratch
+	{
+		TFT_Box(0, 185, 319, 239, BGND_COLOUR);
+		memset(cellBarCache, BAR_CACHE_INVALID, sizeof(cellBarCache));
+		cellBarCount = numCells;
+	}
+
 	int balanceVoltage = 5000;
 	if (settings[BALANCE_VOLTAGE] < 251 && (coreStatus == CHARGING || isBMS16))
 		balanceVoltage = 2000+settings[BALANCE_VOLTAGE]*10;
@@ -1558,9 +3431,10 @@ void DrawCellsBarGraph()
 		for (int id=0; id<MAX_BMS_MODULES; id++)
 			for (int n=0; n<bmsCellCounts[id]; n++)
 			{
-				packVoltage += cellVoltages[id][n];
-				if (cellVoltages[id][n] < minCellVoltage) minCellVoltage = cellVoltages[id][n];
-				if (cellVoltages[id][n] > maxCellVoltage) maxCellVoltage = cellVoltages[id][n];
+				int v = GetCellVoltage(id, n);
+				packVoltage += v;
+				if (v < minCellVoltage) minCellVoltage = v;
+				if (v > maxCellVoltage) maxCellVoltage = v;
 			}
 
 		//balanceVoltage = (long)packVoltage/(long)numCells + BALANCE_TOLERANCE;
@@ -1587,7 +3461,8 @@ void DrawCellsBarGraph()
 		char cells = bmsCellCounts[m];
 		for (uint8_t c=0; c<cells; c++)
 		{
-			int v = cellVoltages[m][c]/10;
+			int millivolts = GetCellVoltage(m, c);
+			int v = millivolts/10;
 
 			U16 col = LIGHT_BLUE;
 			if (v < min)
@@ -1599,30 +3474,61 @@ void DrawCellsBarGraph()
 				col = RED;
 				v = max;
 			}
-			else if (cellVoltages[m][c] > balanceVoltage)
+			else if (millivolts > balanceVoltage)
 				col = ORANGE;
 
-			unsigned int height = 5 + (v - min)*40/range;
-			
-			TFT_Box(margin+n*width+1, 185, margin+(n+1)*width-gap, 238-height, BGND_COLOUR); // Blank out anything above bars
-			TFT_Box(margin+n*width+1, 239-height, margin+(n+1)*width-gap, 239, col);
-			
-			// Add dotted line, one bar at a time to minimise flashing
-			int start = margin+n*width;
-			int end = margin+(n+1)*width;
-			for (int a=start/3; a<=end/3; a++)
+			unsigned char height = 5 + (v - min)*40/range;
+			unsigned char state = (height<<2) | (col == RED ? 1 : col == ORANGE ? 2 : 0);
+			unsigned char oldState = cellBarCache[n];
+			int oldHeight = oldState>>2;
+
+			if (state != oldState)
 			{
-				TFT_H_Line(a*3+1, a*3+1, 194, WHITE);
-				TFT_H_Line(a*3+1, a*3+1, 234, WHITE);
+				int x1 = margin+n*width+1;
+				int x2 = margin+(n+1)*width-gap;
+				int top, bottom; // Rows repainted, for touching up the dotted lines afterwards
 
+				if (oldState == BAR_CACHE_INVALID)
+				{
+					TFT_Box(x1, 185, x2, 238-height, BGND_COLOUR); // Blank out anything above bars
+					TFT_Box(x1, 239-height, x2, 239, col);
+					top = 185;
+					bottom = 239;
+				}
+				else
+				{
+					if ((state & 0x03) != (oldState & 0x03)) // Colour changed, so the whole bar needs repainting
+					{
+						TFT_Box(x1, 239-height, x2, 239, col);
+						if (oldHeight > height) TFT_Box(x1, 239-oldHeight, x2, 238-height, BGND_COLOUR);
+						bottom = 239;
+					}
+					else if (height > oldHeight)
+					{
+						TFT_Box(x1, 239-height, x2, 238-oldHeight, col);
+						bottom = 238-oldHeight;
+					}
+					else
+					{
+						TFT_Box(x1, 239-oldHeight, x2, 238-height, BGND_COLOUR);
+						bottom = 238-height;
+					}
+					top = 239 - Max(height, oldHeight);
+				}
+				cellBarCache[n] = state;
+
+				// Add dotted line back in where this bar has painted over it
+				int start = margin+n*width;
+				int end = margin+(n+1)*width;
+				DrawBarGuide(start, end, 194, top, bottom);
+				DrawBarGuide(start, end, 234, top, bottom);
 				if (settings[STATIONARY_VERSION])
 				{
 					// how many pixels is 0.4V?
-
 					int offset = settings[BMS_HYSTERESIS] * 80 / range;
 
-					TFT_H_Line(a*3+1, a*3+1, 194+offset, WHITE);
-					TFT_H_Line(a*3+1, a*3+1, 234-offset, WHITE);
+					DrawBarGuide(start, end, 194+offset, top, bottom);
+					DrawBarGuide(start, end, 234-offset, top, bottom);
 				}
 			}
 			n++;
@@ -1639,60 +3545,43 @@ void RenderMainViewNoCurrentSensor()
 		char statusText[20];
 		strcpy_P(statusText, (char*)pgm_read_word(&(coreStatuses[coreStatus])));
 		if (isBMS16)
-			strcpy(buffer, "BMS : ");
+			strcpy_P(buffer, PSTR("BMS : "));
 		else
-			strcpy(buffer, "EVMS : ");
+			strcpy_P(buffer, PSTR("EVMS : "));
 		strcat(buffer, statusText);
 		
 		DrawTitlebar(buffer);
 		
-		TFT_Text("Pack voltage", 16, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Temperature", 170, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Isolation", 16, 110, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Aux voltage", 170, 110, 1, LABEL_COLOUR, BGND_COLOUR);			
+		TFT_PropText_P(PSTR("Pack voltage"), 16, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Temperature"), 170, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Isolation"), 16, 110, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Aux voltage"), 170, 110, LABEL_COLOUR, BGND_COLOUR);			
 	}
 
 	int voltage = (evmsStatusBytes[3]<<8) + evmsStatusBytes[4];
 	if (voltage == 0)
-		strcpy(buffer, " -    ");
+		TFT_LargeText_P(PSTR(" -    "), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+	else if (voltage < 1000 && numCells > 0)
+		TFT_Number(voltage, 0, 1, 6, ALIGN_LEFT, PSTR("V"), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-	{
-		if (voltage < 1000 && numCells > 0)
-		{
-			itoa(voltage, buffer, 10);
-			AddDecimalPoint(buffer);
-		}
-		else
-			itoa(voltage/10, buffer, 10);
-	
-		strcat(buffer, "V ");
-	}
-	TFT_Text(buffer, 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(voltage, 1, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	
 	int temperature = evmsStatusBytes[7];
 	if (temperature == 0)
-		strcpy(buffer, " -    ");
+		TFT_LargeText_P(PSTR(" -    "), 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-		WriteTemp(buffer, temperature-40);
-	
-	TFT_Text(buffer, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+		DrawTemp(temperature-40, 6, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	
 	if (voltage == 0)
-		strcpy(buffer, " -    ");
+		TFT_LargeText_P(PSTR(" -    "), 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
 	{
 		int isolation = evmsStatusBytes[6] & 0b01111111; // Bottom 7 bits only
-		int isol = ((isolation+5)/10)*10; // Do some rounding to nearest 10% so it doesn't jiggle too much
-		itoa(isol, buffer, 10); // Leakage
-		strcat(buffer, "%  ");
+		// Leakage, rounded to the nearest 10% so it doesn't jiggle too much
+		TFT_Number((isolation+5)/10*10, 0, 0, 6, ALIGN_LEFT, PSTR("%"), 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
 	}
-	TFT_Text(buffer, 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
 
-	int auxV = evmsStatusBytes[5];
-	itoa(auxV, buffer, 10); // Aux voltage
-	AddDecimalPoint(buffer);
-	strcat(buffer, "V ");
-	TFT_Text(buffer, 170, 130, 2, TEXT_COLOUR, BGND_COLOUR);
+	TFT_Number(evmsStatusBytes[5], 0, 1, 6, ALIGN_LEFT, PSTR("V"), 170, 130, 2, TEXT_COLOUR, BGND_COLOUR); // Aux voltage
 
 	if (numCells > 0) DrawCellsBarGraph();
 }
@@ -1706,51 +3595,35 @@ void RenderMCStatus()
 		//char statusText[20];
 		switch (mcStatusBytes[0] & 0x0F)
 		{
-			case MC600C: DrawTitlebar("MC600C Status"); break;
-			case MC1000C: DrawTitlebar("MC1000C Status"); break;
-			default: DrawTitlebar("(Unknown Controller)"); break;
+			case MC600C: DrawTitlebar_P(PSTR("MC600C Status")); break;
+			case MC1000C: DrawTitlebar_P(PSTR("MC1000C Status")); break;
+			default: DrawTitlebar_P(PSTR("(Unknown Controller)")); break;
 		}		
 
-		TFT_Text("Batt Volts", 16, 30, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Batt Amps", 170, 30, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Batt Volts"), 16, 30, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Batt Amps"), 170, 30, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_Text("Motor Volts", 16, 88, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Motor Amps", 170, 88, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Motor Volts"), 16, 88, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Motor Amps"), 170, 88, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_Text("Temp", 16, 146, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Throttle", 170, 146, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Temp"), 16, 146, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Throttle"), 170, 146, LABEL_COLOUR, BGND_COLOUR);
 	}
 
 	// Dynamic parts
 
-	if (mcCanTimeout > 0) // 1 second
+	if (!IsStale(SOURCE_MC))
 	{
 		int battVolts = mcStatusBytes[1] + (mcStatusBytes[6]&0b10000000)*2;
 		int pwm = mcStatusBytes[7];
 		int motorVolts = (long)battVolts * (long)pwm / 255L;
 		
-		itoa(battVolts, buffer, 10); // Batt volts
-		strcat(buffer, "V  ");
-		TFT_Text(buffer, 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
-	
-		itoa(mcStatusBytes[2]*5, buffer, 10); // Batt amps
-		strcat(buffer, "A  ");
-		TFT_Text(buffer, 170, 48, 2, TEXT_COLOUR, BGND_COLOUR);
-	
-		itoa(motorVolts, buffer, 10); // Motor volts
-		strcat(buffer, "V  ");
-		TFT_Text(buffer, 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
-
-		itoa(mcStatusBytes[4]*5, buffer, 10); // Motor amps
-		strcat(buffer, "A  ");
-		TFT_Text(buffer, 170, 106, 2, TEXT_COLOUR, BGND_COLOUR);
-
-		WriteTemp(buffer, mcStatusBytes[5]); // Temp
-		TFT_Text(buffer, 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
-
-		itoa(mcStatusBytes[6]&0b01111111, buffer, 10); // Throttle
-		strcat(buffer, "%   ");
-		TFT_Text(buffer, 170, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(battVolts, 0, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 48, 2, TEXT_COLOUR, BGND_COLOUR); // Batt volts
+		TFT_Number(mcStatusBytes[2]*5, 0, 0, 6, ALIGN_LEFT, PSTR("A"), 170, 48, 2, TEXT_COLOUR, BGND_COLOUR); // Batt amps
+		TFT_Number(motorVolts, 0, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 106, 2, TEXT_COLOUR, BGND_COLOUR); // Motor volts
+		TFT_Number(mcStatusBytes[4]*5, 0, 0, 6, ALIGN_LEFT, PSTR("A"), 170, 106, 2, TEXT_COLOUR, BGND_COLOUR); // Motor amps
+		DrawTemp(mcStatusBytes[5], 6, 16, 164, 2, TEXT_COLOUR, BGND_COLOUR); // Temp
+		TFT_Number(mcStatusBytes[6]&0b01111111, 0, 0, 6, ALIGN_LEFT, PSTR("%"), 170, 164, 2, TEXT_COLOUR, BGND_COLOUR); // Throttle
 
 		int mcError = mcStatusBytes[0]>>4;
 		unsigned short col = RED;
@@ -1758,27 +3631,27 @@ void RenderMCStatus()
 		if (mcError == MC_SLEEPING) col = L_GRAY;
 		if (mcError == MC_NO_ERROR) col = GREEN;
 
-		TFT_CentredText(mcErrors[mcError], 160, 210, 1, col, BGND_COLOUR);
+		TFT_CentredText_P((const char*)pgm_read_word(&mcErrors[mcError]), 160, 210, 1, col, BGND_COLOUR);
 	}
 	else // Comms error
 	{
-		strcpy(buffer, " -   ");
-		TFT_Text(buffer, 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(buffer, 170, 48, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(buffer, 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(buffer, 170, 106, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(buffer, 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(buffer, 170, 164, 2, TEXT_COLOUR, BGND_COLOUR);
-
-		TFT_CentredText("   COMMS ERROR!   ", 160, 210, 1, RED, BGND_COLOUR);
+		strcpy_P(buffer, PSTR(" -   "));
+		TFT_LargeText(buffer, 16, 48, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText(buffer, 170, 48, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText(buffer, 16, 106, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText(buffer, 170, 106, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText(buffer, 16, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText(buffer, 170, 164, 2, TEXT_COLOUR, BGND_COLOUR);
+
+		TFT_CentredText_P(PSTR("   COMMS ERROR!   "), 160, 210, 1, RED, BGND_COLOUR);
 	}
 }
 
 void RenderChargerStatus()
 {
-	if (numChargers == 3)
+	if (numChargers > 1)
 	{
-		RenderThreeChargerStatus();
+		RenderMultiChargerStatus();
 		return;
 	}
 	
@@ -1786,177 +3659,137 @@ void RenderChargerStatus()
 	{
 		displayNeedsFullRedraw = false;
 
-		DrawTitlebar("TC Charger Status");		
+		DrawTitlebar_P(PSTR("TC Charger Status"));		
 
-		TFT_Text("Output Volt", 16, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Output Amps", 170, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Output Volt"), 16, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Output Amps"), 170, 40, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_Text("Target Volt", 16, 110, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Target Amps", 170, 110, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Target Volt"), 16, 110, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Target Amps"), 170, 110, LABEL_COLOUR, BGND_COLOUR);
 	}
 
 	// Dynamic parts
 	if (charger[0].instVoltage > 0)
-	{
-		itoa(charger[0].instVoltage/10, buffer, 10); // Output volts
-		strcat(buffer, "V  ");
-	}
+		TFT_Number(charger[0].instVoltage, 1, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR); // Output volts
 	else
-		strcpy(buffer, " -   ");
-	TFT_Text(buffer, 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR(" -    "), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	
 	if (charger[0].instCurrent > 0)
-	{
-		itoa(charger[0].instCurrent, buffer, 10); // Output amps
-		AddDecimalPoint(buffer);
-		strcat(buffer, "A  ");
-	}
+		TFT_Number(charger[0].instCurrent, 0, 1, 6, ALIGN_LEFT, PSTR("A"), 170, 60, 2, TEXT_COLOUR, BGND_COLOUR); // Output amps
 	else
-		strcpy(buffer, " -    ");
-	TFT_Text(buffer, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR(" -    "), 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 
-	itoa(charger[0].targetVoltage/10, buffer, 10); // Target volts
-	strcat(buffer, "V  ");
-	TFT_Text(buffer, 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
+	TFT_Number(charger[0].targetVoltage, 1, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 130, 2, TEXT_COLOUR, BGND_COLOUR); // Target volts
+	TFT_Number(charger[0].targetCurrent, 0, 1, 6, ALIGN_LEFT, PSTR("A"), 170, 130, 2, TEXT_COLOUR, BGND_COLOUR); // Target amps
 
-	itoa(charger[0].targetCurrent, buffer, 10); // Target amps
-	AddDecimalPoint(buffer);
-	strcat(buffer, "A  ");
-	TFT_Text(buffer, 170, 130, 2, TEXT_COLOUR, BGND_COLOUR);
-
-	if (chargerCommsTimeout[0] == 0)
-		TFT_CentredText("No comms to charger", 160, 200, 1, RED, BGND_COLOUR);
+	if (charger[0].commsTimeout == 0)
+		TFT_CentredText_P(PSTR("No comms to charger"), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].controlBit)
-		TFT_CentredText("  Shutdown by BMS  ", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("  Shutdown by BMS  "), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].statusBits & 0b00000001)
-		TFT_CentredText(" Hardware failure! ", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR(" Hardware failure! "), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].statusBits & 0b00000010)
-		TFT_CentredText(" Overtemp shutdown ", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR(" Overtemp shutdown "), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].statusBits & 0b00000100)
-		TFT_CentredText("Input voltage error", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("Input voltage error"), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].statusBits & 0b00001000)
-		TFT_CentredText("   Battery Fault   ", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("   Battery Fault   "), 160, 200, 1, RED, BGND_COLOUR);
 	else if (charger[0].statusBits & 0b00010000)
-		TFT_CentredText("   Comms timeout   ", 160, 200, 1, RED, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("   Comms timeout   "), 160, 200, 1, RED, BGND_COLOUR);
 	else
-		TFT_CentredText(" Charger status OK ", 160, 200, 1, GREEN, BGND_COLOUR);
+		TFT_CentredText_P(PSTR(" Charger status OK "), 160, 200, 1, GREEN, BGND_COLOUR);
 }
 
-void RenderThreeChargerStatus()
+void RenderMultiChargerStatus()
 {
-	int divisor = 1;
-	if (charger[0].targetCurrent*numChargers > 1000) divisor = 10; // If dealing with 100.0A or more, drop decimal point
+	char ampsDecimals = 1;
+	if (charger[0].targetCurrent*numChargers > 1000) ampsDecimals = 0; // If dealing with 100.0A or more, drop decimal point
 
 	if (displayNeedsFullRedraw) // Render static parts
 	{
 		displayNeedsFullRedraw = false;
 
-		DrawTitlebar("Charger Status");		
+		DrawTitlebar_P(PSTR("Charger Status"));		
 
-		TFT_Text("Output Volts", 16, 30, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Total Amps", 170, 30, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Output Volts"), 16, 30, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Total Amps"), 170, 30, LABEL_COLOUR, BGND_COLOUR);
 		
-		TFT_Text("Target Volts", 16, 90, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Target Amps", 170, 90, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Target Volts"), 16, 90, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Target Amps"), 170, 90, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_Text("#", 16, 150, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Volts", 60, 150, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Amps", 132, 150, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Status", 204, 150, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_Text_P(PSTR("#"), 16, 150, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Volts"), 60, 150, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Amps"), 132, 150, LABEL_COLOUR, BGND_COLOUR);
 	}
 
 	// Dynamic parts
-	int voltage = 0;
-	for (int n=0; n<numChargers; n++) if (charger[n].instVoltage > voltage) voltage = charger[n].instVoltage;
-	itoa(voltage/10, buffer, 10); // Output volts
-	strcat(buffer, "V  ");
-	TFT_Text(buffer, 16, 50, 2, TEXT_COLOUR, BGND_COLOUR);
-
-	int current = 0;
-	for (int n=0; n<3; n++) current += charger[n].instCurrent;
-	itoa(current/divisor, buffer, 10); // Output amps
-	if (divisor == 1) AddDecimalPoint(buffer);
-	strcat(buffer, "A  ");
-	TFT_Text(buffer, 170, 50, 2, TEXT_COLOUR, BGND_COLOUR);
+	cli(); // Totals are updated from CAN RX
+	long totalCurrent = chargersTotalCurrent;
+	short maxVoltage = chargersMaxVoltage;
+	U8 faulted = chargersFaulted;
+	sei();
+	TFT_Number(maxVoltage, 1, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 50, 2, TEXT_COLOUR, BGND_COLOUR); // Output volts
+	TFT_Number(totalCurrent, 1-ampsDecimals, ampsDecimals, 6, ALIGN_LEFT, PSTR("A"), 170, 50, 2, TEXT_COLOUR, BGND_COLOUR); // Output amps
 	
-	voltage = settings[CHARGER_VOLTAGE];
+	int voltage = settings[CHARGER_VOLTAGE];
 	if (settings[CHARGER_CURRENT] & 0b10000000) voltage += 256;
-	current = (settings[CHARGER_CURRENT]&0b01111111)*numChargers;
+	int current = (settings[CHARGER_CURRENT]&0b01111111)*numChargers;
 	
-	itoa(voltage, buffer, 10); // Target volts - same for all chargers
-	strcat(buffer, "V  ");
-	TFT_Text(buffer, 16, 110, 2, TEXT_COLOUR, BGND_COLOUR);
+	TFT_Number(voltage, 0, 0, 6, ALIGN_LEFT, PSTR("V"), 16, 110, 2, TEXT_COLOUR, BGND_COLOUR); // Target volts - same for all chargers
+	TFT_Number(current*10, 1-ampsDecimals, ampsDecimals, 6, ALIGN_LEFT, PSTR("A"), 170, 110, 2, TEXT_COLOUR, BGND_COLOUR); // Target amps
 
-	itoa(current*10/divisor, buffer, 10); // Target amps
-	if (divisor == 1) AddDecimalPoint(buffer);
-	strcat(buffer, "A  ");
-	TFT_Text(buffer, 170, 110, 2, TEXT_COLOUR, BGND_COLOUR);
+	// Fault summary in place of the status column heading, e.g "5/6 OK"
+	U16 col = faulted ? RED : GREEN;
+	unsigned int x = TFT_Number(numChargers-faulted, 0, 0, 0, ALIGN_LEFT, PSTR("/"), 204, 150, 1, col, BGND_COLOUR);
+	TFT_Number(numChargers, 0, 0, 5, ALIGN_LEFT, PSTR(" OK"), x, 150, 1, col, BGND_COLOUR);
 
-	for (int n=0; n<3; n++)
+	for (int row=0; row<CHARGER_ROWS; row++)
 	{
-		itoa(n+1, buffer, 10);
-		TFT_Text(buffer, 16, 170+n*20, 1, TEXT_COLOUR, BGND_COLOUR);
-
-		itoa(charger[n].instVoltage/10, buffer, 10); // Output volts
-		strcat(buffer, "V ");
-		TFT_Text(buffer, 60, 170+n*20, 1, TEXT_COLOUR, BGND_COLOUR);
+		int n = chargerScroll + row;
+		int y = 170+row*20;
+		if (n >= numChargers) // Last page of a scrolling list can be short
+		{
+			TFT_Box(16, y, 319, y+15, BGND_COLOUR);
+			continue;
+		}
 
-		itoa(charger[n].instCurrent/divisor, buffer, 10); // Output amps
-		if (divisor == 1) AddDecimalPoint(buffer);
-		strcat(buffer, "A ");
-		TFT_Text(buffer, 132, 170+n*20, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(n+1, 0, 0, 2, ALIGN_LEFT, PSTR(""), 16, y, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(charger[n].instVoltage, 1, 0, 5, ALIGN_LEFT, PSTR("V"), 60, y, 1, TEXT_COLOUR, BGND_COLOUR); // Output volts
+		TFT_Number(charger[n].instCurrent, 1-ampsDecimals, ampsDecimals, 5, ALIGN_LEFT, PSTR("A"), 132, y, 1, TEXT_COLOUR, BGND_COLOUR); // Output amps
 
-		if (chargerCommsTimeout[n] == 0)
-			TFT_Text("No comms", 204, 170+n*20, 1, RED, BGND_COLOUR);
+		if (charger[n].commsTimeout == 0)
+			TFT_Text_P(PSTR("No comms"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].controlBit)
-			TFT_Text("BMS Stop", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("BMS Stop"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].statusBits & 0b00000001)
-			TFT_Text("HW Fault", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("HW Fault"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].statusBits & 0b00000010)
-			TFT_Text("Overtemp", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("Overtemp"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].statusBits & 0b00000100)
-			TFT_Text("AC fault", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("AC fault"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].statusBits & 0b00001000)
-			TFT_Text("BatError", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("BatError"), 204, y, 1, RED, BGND_COLOUR);
 		else if (charger[n].statusBits & 0b00010000)
-			TFT_Text("No comms", 204, 170+n*20, 1, RED, BGND_COLOUR);
+			TFT_Text_P(PSTR("No comms"), 204, y, 1, RED, BGND_COLOUR);
 		else
-			TFT_Text("OK      ", 204, 170+n*20, 1, GREEN, BGND_COLOUR);
+			TFT_Text_P(PSTR("OK      "), 204, y, 1, GREEN, BGND_COLOUR);
 	}
 }
 
+// e.g "M3 C12", with spaces after to blank any longer previous location
+void DrawCellLocation(unsigned char module, unsigned char cell, unsigned int x, unsigned int y)
+{
+	TFT_Text_P(PSTR("M"), x, y, 1, L_GRAY, BGND_COLOUR);
+	x = TFT_Number(module, 0, 0, 0, ALIGN_LEFT, PSTR(""), x+12, y, 1, L_GRAY, BGND_COLOUR);
+	TFT_Text_P(PSTR(" C"), x, y, 1, L_GRAY, BGND_COLOUR);
+	TFT_Number(cell, 0, 0, 4, ALIGN_LEFT, PSTR(""), x+24, y, 1, L_GRAY, BGND_COLOUR);
+}
+
 void RenderBMSSummary()
 {
 	// Do the calculations
-	unsigned short minVoltage = 5000, maxVoltage = 0;
-	unsigned char minModule = 0, minCell = 0, maxModule = 0, maxCell = 0;
-
-	long packVoltage = 0;
-	for (int id=0; id<MAX_BMS_MODULES; id++)
-	{
-		if (bmsCellCounts[id] > 0)
-		{
-			for (int n=0; n<bmsCellCounts[id]; n++)
-			{
-				if (cellVoltages[id][n] < minVoltage)
-				{
-					minVoltage = cellVoltages[id][n];
-					minModule = id;
-					minCell = n+1;
-				}
-				if (cellVoltages[id][n] > maxVoltage)
-				{
-					maxVoltage = cellVoltages[id][n];
-					maxModule = id;
-					maxCell = n+1;
-				}
-				packVoltage += cellVoltages[id][n];
-			}
-		}
-	}
-
-	long avgVoltage = 0;
-	if (numCells > 0) avgVoltage = (long)packVoltage/(long)numCells;
+	PackSummary s;
+	SummarisePack(&s);
 
 	int avgTemp = 0, numTempSensors = 0;
 	for (int n=0; n<MAX_BMS_MODULES; n++)
@@ -1981,81 +3814,44 @@ void RenderBMSSummary()
 
 		char stringy[4];
 		itoa(numCells, stringy, 10);
-		strcpy(buffer, "BMS Summary : ");
+		strcpy_P(buffer, PSTR("BMS Summary : "));
 		strcat(buffer, stringy);
-		strcat(buffer, " cells");
+		strcat_P(buffer, PSTR(" cells"));
 
 		DrawTitlebar(buffer);
 		
 		if (isBMS16 && settings[SHUNT_SIZE] == 0 && !haveReceivedCurrentData) 
-			TFT_Text("Pack voltage", 16, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+			TFT_PropText_P(PSTR("Pack voltage"), 16, 40, LABEL_COLOUR, BGND_COLOUR);
 		else
-			TFT_Text("Avg voltage", 16, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+			TFT_PropText_P(PSTR("Avg voltage"), 16, 40, LABEL_COLOUR, BGND_COLOUR);
 		
 		
 		
 		if (isBMS16)
-			TFT_Text("Temperature", 170, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+			TFT_PropText_P(PSTR("Temperature"), 170, 40, LABEL_COLOUR, BGND_COLOUR);
 		else
-			TFT_Text("Avg temp", 170, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Min voltage", 16, 110, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_Text("Max voltage", 170, 110, 1, LABEL_COLOUR, BGND_COLOUR);			
+			TFT_PropText_P(PSTR("Avg temp"), 170, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Min voltage"), 16, 110, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Max voltage"), 170, 110, LABEL_COLOUR, BGND_COLOUR);			
 	}
 	
 	if (isBMS16 && settings[SHUNT_SIZE] == 0 && !haveReceivedCurrentData)
-	{
-		itoa(packVoltage/100, buffer, 10);
-		AddDecimalPoint(buffer);
-	}
+		TFT_Number(s.packVoltage, 2, 1, 6, ALIGN_LEFT, PSTR("V"), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-	{
-		itoa((avgVoltage+5)/10, buffer, 10); // The +5 is so it rounds not truncates
-		AddDecimalPoint2(buffer);
-	}
-	strcat(buffer, "V ");
-	TFT_Text(buffer, 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(s.avgVoltage, 1, 2, 6, ALIGN_LEFT, PSTR("V"), 16, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	
 	if (isBMS16 && evmsStatusBytes[7] > 0)
-	{
-		WriteTemp(buffer, evmsStatusBytes[7]-40);
-		TFT_Text(buffer, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
-	}
+		DrawTemp(evmsStatusBytes[7]-40, 6, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	else if (numTempSensors > 0)
-	{
-		WriteTemp(buffer, avgTemp-40);
-		TFT_Text(buffer, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
-	}
+		DrawTemp(avgTemp-40, 6, 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
 	else
-		TFT_Text(" -   ", 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
-
-	itoa((minVoltage+5)/10, buffer, 10);
-	AddDecimalPoint2(buffer);
-	strcat(buffer, "V");
-	TFT_Text(buffer, 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
-
-	char texty[12];
-	strcpy(texty, "M");
-	itoa(minModule, buffer, 10);
-	strcat(texty, buffer);
-	strcat(texty, " C");
-	itoa(minCell, buffer, 10);
-	strcat(texty, buffer);
-	strcat(texty, " ");
-	TFT_Text(texty, 16, 165, 1, L_GRAY, BGND_COLOUR);
-
-	itoa((maxVoltage+5)/10, buffer, 10);
-	AddDecimalPoint2(buffer);
-	strcat(buffer, "V");
-	TFT_Text(buffer, 170, 130, 2, TEXT_COLOUR, BGND_COLOUR);
-
-	strcpy(texty, "M");
-	itoa(maxModule, buffer, 10);
-	strcat(texty, buffer);
-	strcat(texty, " C");
-	itoa(maxCell, buffer, 10);
-	strcat(texty, buffer);
-	strcat(texty, " ");
-	TFT_Text(texty, 170, 165, 1, L_GRAY, BGND_COLOUR);
+		TFT_LargeText_P(PSTR(" -    "), 170, 60, 2, TEXT_COLOUR, BGND_COLOUR);
+
+	TFT_Number(s.minVoltage, 1, 2, 5, ALIGN_LEFT, PSTR("V"), 16, 130, 2, TEXT_COLOUR, BGND_COLOUR);
+	DrawCellLocation(s.minModule, s.minCell, 16, 165);
+
+	TFT_Number(s.maxVoltage, 1, 2, 5, ALIGN_LEFT, PSTR("V"), 170, 130, 2, TEXT_COLOUR, BGND_COLOUR);
+	DrawCellLocation(s.maxModule, s.maxCell, 170, 165);
 
 	DrawCellsBarGraph();
 }
@@ -2074,9 +3870,10 @@ void RenderBMSDetails()
 		for (int id=0; id<MAX_BMS_MODULES; id++)
 			for (int n=0; n<bmsCellCounts[id]; n++)
 			{
-				packVoltage += cellVoltages[id][n];
-				if (cellVoltages[id][n] < minCellVoltage) minCellVoltage = cellVoltages[id][n];
-				if (cellVoltages[id][n] > maxCellVoltage) maxCellVoltage = cellVoltages[id][n];
+				int v = GetCellVoltage(id, n);
+				packVoltage += v;
+				if (v < minCellVoltage) minCellVoltage = v;
+				if (v > maxCellVoltage) maxCellVoltage = v;
 			}
 
 		//balanceVoltage = (long)packVoltage/(long)numCells + BALANCE_TOLERANCE;
@@ -2093,18 +3890,18 @@ void RenderBMSDetails()
 		{
 			char stringy[4];
 			itoa(numCells, stringy, 10);
-			strcpy(buffer, "BMS Details : ");
+			strcpy_P(buffer, PSTR("BMS Details : "));
 			strcat(buffer, stringy);
-			strcat(buffer, " cells");
+			strcat_P(buffer, PSTR(" cells"));
 			DrawTitlebar(buffer);
 		}
 		else
 		{
-			DrawTitlebar("BMS Details : Module  ");
-			TFT_Text("Temp1:", 12, 165, 1, LABEL_COLOUR, BGND_COLOUR);
-			TFT_Text("Temp2:", 162, 165, 1, LABEL_COLOUR, BGND_COLOUR);
+			DrawTitlebar_P(PSTR("BMS Details : Module  "));
+			TFT_PropText_P(PSTR("Temp1:"), 12, 165, LABEL_COLOUR, BGND_COLOUR);
+			TFT_PropText_P(PSTR("Temp2:"), 162, 165, LABEL_COLOUR, BGND_COLOUR);
 		}
-		TFT_Text("Cell Voltages", 12, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Cell Voltages"), 12, 40, LABEL_COLOUR, BGND_COLOUR);
 	}
 
 	U16 col = RUNNING_COLOUR;
@@ -2112,28 +3909,23 @@ void RenderBMSDetails()
 		currentBmsModule = 0;
 	else
 	{
-		itoa(currentBmsModule, buffer, 10);
-		strcat(buffer, " ");
 		if (coreStatus == CHARGING) col = CHARGING_COLOUR;
 		if (coreStatus == IDLE) col = L_GRAY;
 		if (coreStatus == STOPPED) col = RED;
 		if (settings[STATIONARY_VERSION] && (error == BMS_HIGH_WARNING || error == BMS_LOW_WARNING)) col = RED;
-		TFT_Text(buffer, 274, 2, 1, TEXT_COLOUR, col);
+		TFT_Number(currentBmsModule, 0, 0, 2, ALIGN_LEFT, PSTR(""), 274, 2, 1, TEXT_COLOUR, col);
 	}
 
-	// Matrix of voltages
+	// Matrix of voltages, greyed out if the module's gone quiet
 	int max = 12;
 	if (isBMS16 && !isActuallyBMS12i) max = 8;
+	U16 cellColour = IsStale(SOURCE_BMS + currentBmsModule) ? D_GRAY : TEXT_COLOUR;
 	for (int n=0; n<max; n++)
 	{
 		if (n < bmsCellCounts[currentBmsModule])
-		{
-			itoa(cellVoltages[currentBmsModule][n], buffer, 10);
-			AddDecimalPoint3(buffer);
-		}
+			TFT_Number(GetCellVoltage(currentBmsModule, n), 0, 3, 5, ALIGN_LEFT, PSTR(""), 12+75*(n&0x03), 70+30*(n/4), 1, cellColour, BGND_COLOUR);
 		else
-			strcpy(buffer, "     "); // blanking spaces to clear any old entries
-		TFT_Text(buffer, 12+75*(n&0x03), 70+30*(n/4), 1, TEXT_COLOUR, BGND_COLOUR);
+			TFT_Text_P(PSTR("     "), 12+75*(n&0x03), 70+30*(n/4), 1, TEXT_COLOUR, BGND_COLOUR); // blanking spaces to clear any old entries
 	}
 
 	if (isBMS16) // Write next 8 cells
@@ -2143,13 +3935,10 @@ void RenderBMSDetails()
 			for (int n=0; n<8; n++)
 			{
 				if (n < bmsCellCounts[1])
-				{
-					itoa(cellVoltages[1][n], buffer, 10);
-					AddDecimalPoint3(buffer);
-				}
+					TFT_Number(GetCellVoltage(1, n), 0, 3, 5, ALIGN_LEFT, PSTR(""), 12+75*(n&0x03), 130+30*(n/4), 1,
+						IsStale(SOURCE_BMS + 1) ? D_GRAY : TEXT_COLOUR, BGND_COLOUR);
 				else
-					strcpy(buffer, "     "); // blanking spaces to clear any old entries
-				TFT_Text(buffer, 12+75*(n&0x03), 130+30*(n/4), 1, TEXT_COLOUR, BGND_COLOUR);
+					TFT_Text_P(PSTR("     "), 12+75*(n&0x03), 130+30*(n/4), 1, TEXT_COLOUR, BGND_COLOUR); // blanking spaces to clear any old entries
 			}
 		}
 		DrawCellsBarGraph();
@@ -2157,29 +3946,390 @@ void RenderBMSDetails()
 	else
 	{
 		if (bmsTemps[currentBmsModule][1] == 0)
-			strcpy(buffer, " -   ");
+			TFT_Text_P(PSTR(" -   "), 96, 165, 1, TEXT_COLOUR, BGND_COLOUR);
 		else
-			WriteTemp(buffer, bmsTemps[currentBmsModule][1]-40);
-		TFT_Text(buffer, 96, 165, 1, TEXT_COLOUR, BGND_COLOUR);
+			DrawTemp(bmsTemps[currentBmsModule][1]-40, 5, 96, 165, 1, TEXT_COLOUR, BGND_COLOUR);
 
 		if (bmsTemps[currentBmsModule][0] == 0)
-			strcpy(buffer, " -   ");
+			TFT_Text_P(PSTR(" -   "), 246, 165, 1, TEXT_COLOUR, BGND_COLOUR);
 		else
-			WriteTemp(buffer, bmsTemps[currentBmsModule][0]-40);
-		TFT_Text(buffer, 246, 165, 1, TEXT_COLOUR, BGND_COLOUR);
+			DrawTemp(bmsTemps[currentBmsModule][0]-40, 5, 246, 165, 1, TEXT_COLOUR, BGND_COLOUR);
 
 		for (int n=0; n<12; n++)
 		{
 			col = BGND_COLOUR;
-			if (cellVoltages[currentBmsModule][n] > balanceVoltage) col = ORANGE; // +5 mV tolerance for balancing
+			if (GetCellVoltage(currentBmsModule, n) > balanceVoltage) col = ORANGE; // +5 mV tolerance for balancing
 			TFT_Box(12+75*(n&0x03), 88+30*(n/4), 72+75*(n&0x03), 89+30*(n/4), col);
 		}
 	
+		if (settings[BMS_POLL_LOAD] > 0) // How this module is answering our requests
+		{
+			TFT_Number(bmsPoller.module[currentBmsModule].latency, 0, 0, 4, ALIGN_RIGHT, PSTR("ms"), 124, 190, 1, TEXT_COLOUR, BGND_COLOUR);
+			TFT_Number(bmsPoller.module[currentBmsModule].missed, 0, 0, 4, ALIGN_RIGHT, PSTR("mis"), 118, 214, 1,
+				bmsPoller.module[currentBmsModule].missed ? ORANGE : TEXT_COLOUR, BGND_COLOUR);
+		}
+
 		RenderButton(&nextBmsModuleButton, fullRedraw);
 		RenderButton(&prevBmsModuleButton, fullRedraw);
 	}
 }
 
+void RenderDiagnostics()
+{
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+
+		DrawTitlebar_P(PSTR("Diagnostics"));
+		TFT_PropText_P(PSTR("Static RAM"), 16, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Stack free now"), 16, 70, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Stack never used"), 16, 100, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Main loop depth"), 16, 130, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Timer0 ISR depth"), 16, 160, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Timer1 ISR depth"), 16, 190, LABEL_COLOUR, BGND_COLOUR);
+#if CAN_BRIDGE
+		TFT_PropText_P(PSTR("Bridge drops"), 16, 220, LABEL_COLOUR, BGND_COLOUR);
+#endif
+	}
+
+	TFT_Number(&_end - (U8*)RAMSTART, 0, 0, 5, ALIGN_RIGHT, PSTR(" bytes"), 200, 40, 1, TEXT_COLOUR, BGND_COLOUR);
+	TFT_Number((U8*)SP - &_end, 0, 0, 5, ALIGN_RIGHT, PSTR(" bytes"), 200, 70, 1, TEXT_COLOUR, BGND_COLOUR);
+	U16 neverUsed = StackNeverUsed();
+	TFT_Number(neverUsed, 0, 0, 5, ALIGN_RIGHT, PSTR(" bytes"), 200, 100, 1,
+		neverUsed < 256 ? RED : TEXT_COLOUR, BGND_COLOUR); // Getting uncomfortably close
+	for (int n=0; n<STACK_NUM_CONTEXTS; n++)
+	{
+		cli();
+		U16 depth = stackMaxDepth[n];
+		sei();
+		TFT_Number(depth, 0, 0, 5, ALIGN_RIGHT, PSTR(" bytes"), 200, 130+n*30, 1, TEXT_COLOUR, BGND_COLOUR);
+	}
+#if CAN_BRIDGE
+	cli();
+	U16 drops = bridgeStats.txDropped + bridgeStats.rxDropped;
+	sei();
+	TFT_Number(drops, 0, 0, 5, ALIGN_RIGHT, PSTR(""), 200, 220, 1, TEXT_COLOUR, BGND_COLOUR);
+#endif
+}
+
+// One labelled value in a two column grid, slots numbered left to right then down
+static void DrawCanStat(U8 slot, const char* label, long value, bool drawLabel)
+{
+	unsigned int x = (slot & 0x01) ? 168 : 8;
+	unsigned int y = 28 + (slot>>1)*21;
+	if (drawLabel) TFT_PropText_P(label, x, y, LABEL_COLOUR, BGND_COLOUR);
+	TFT_Number(value, 0, 0, 5, ALIGN_RIGHT, PSTR(""), x+88, y, 1, TEXT_COLOUR, BGND_COLOUR);
+}
+
+void RenderCanDiagnostics()
+{
+	bool labels = displayNeedsFullRedraw;
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("CAN Diagnostics"));
+	}
+
+	cli(); // All updated by the RX poll
+	CanStats stats = canStats;
+	CanSupervisor supervisor = canSupervisor;
+	U16 refreshTime = bmsPoller.refreshTime;
+	sei();
+
+	DrawCanStat(0, PSTR("Bus load %"), stats.busLoad, labels);
+	DrawCanStat(1, PSTR("TX /s"), stats.txPerSecond, labels);
+	DrawCanStat(2, PSTR("Core /s"), stats.framesPerSecond[CAN_STAT_CORE], labels);
+	DrawCanStat(3, PSTR("Shunt /s"), stats.framesPerSecond[CAN_STAT_CURRENT], labels);
+	DrawCanStat(4, PSTR("MC /s"), stats.framesPerSecond[CAN_STAT_MC], labels);
+	DrawCanStat(5, PSTR("BMS /s"), stats.framesPerSecond[CAN_STAT_BMS], labels);
+	DrawCanStat(6, PSTR("Charger /s"), stats.framesPerSecond[CAN_STAT_CHARGER], labels);
+	DrawCanStat(7, PSTR("Other /s"), stats.framesPerSecond[CAN_STAT_OTHER], labels);
+	DrawCanStat(8, PSTR("TX errors"), CANTEC, labels);
+	DrawCanStat(9, PSTR("RX errors"), CANREC, labels);
+	DrawCanStat(10, PSTR("Bit errs"), stats.mobErrors[CAN_BIT_ERRORS], labels);
+	DrawCanStat(11, PSTR("Stuff errs"), stats.mobErrors[CAN_STUFF_ERRORS], labels);
+	DrawCanStat(12, PSTR("CRC errs"), stats.mobErrors[CAN_CRC_ERRORS], labels);
+	DrawCanStat(13, PSTR("Form errs"), stats.mobErrors[CAN_FORM_ERRORS], labels);
+	DrawCanStat(14, PSTR("ACK errs"), stats.mobErrors[CAN_ACK_ERRORS], labels);
+	DrawCanStat(15, PSTR("TX failed"), stats.txErrors, labels);
+	DrawCanStat(16, PSTR("MOBs full"), stats.mobsFull, labels);
+	if (settings[BMS_POLL_LOAD] > 0) DrawCanStat(17, PSTR("BMS pack ms"), refreshTime, labels);
+	DrawCanStat(18, PSTR("Bus offs"), supervisor.busOffs, labels);
+	DrawCanStat(19, PSTR("Recovery ms"), supervisor.lastRecovery, labels);
+
+	// Controller's error state, from the transmit and receive error counters. The grid fills the page,
+	// so it goes at the right of the title bar, on the page background so the colours show on any title.
+	// Five characters is all that fits from x=256
+	if (CANGSTA & (1<<BOFF) || supervisor.state == CAN_BUS_OFF)
+		TFT_Text_P(PSTR("BOff "), 256, 2, 1, RED, BGND_COLOUR);
+	else if (supervisor.state == CAN_RECOVERING)
+		TFT_Text_P(PSTR("Rstrt"), 256, 2, 1, ORANGE, BGND_COLOUR);
+	else if (CANGSTA & (1<<ERRP))
+		TFT_Text_P(PSTR("ErPas"), 256, 2, 1, ORANGE, BGND_COLOUR);
+	else
+		TFT_Text_P(PSTR("ErAct"), 256, 2, 1, GREEN, BGND_COLOUR);
+}
+
+// Time between updates from each source, on the same grid as the CAN diagnostics. Greyed out once stale
+void RenderDataAge()
+{
+	static const char sourceNames[SOURCE_BMS][8] PROGMEM = { "Core", "Shunt", "MC", "Charger" };
+	bool labels = displayNeedsFullRedraw;
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("Update Intervals (ms)"));
+	}
+
+	for (U8 s=0; s<NUM_SOURCES && s<20; s++)
+	{
+		if (s >= SOURCE_BMS && bmsCellCounts[s-SOURCE_BMS] == 0) continue;
+		unsigned int x = (s & 0x01) ? 168 : 8;
+		unsigned int y = 28 + (s>>1)*21;
+		if (labels)
+		{
+			if (s < SOURCE_BMS)
+				strcpy_P(buffer, sourceNames[s]);
+			else
+			{
+				strcpy_P(buffer, PSTR("BMS "));
+				itoa(s-SOURCE_BMS, buffer+4, 10);
+			}
+			TFT_PropText(buffer, x, y, LABEL_COLOUR, BGND_COLOUR);
+		}
+		cli();
+		U16 interval = freshness[s].interval;
+		bool stale = !freshness[s].fresh;
+		sei();
+		TFT_Number(interval, 0, 0, 5, ALIGN_RIGHT, PSTR(""), x+88, y, 1, stale ? D_GRAY : TEXT_COLOUR, BGND_COLOUR);
+	}
+}
+
+// The cells with the highest resistance estimates, against the pack average
+#define WEAKEST_CELLS_SHOWN	8
+void RenderCellResistance()
+{
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("Cell Resistance (mOhm)"));
+		TFT_PropText_P(PSTR("Average"), 16, 30, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Steps"), 200, 30, LABEL_COLOUR, BGND_COLOUR);
+	}
+
+	// One pass, keeping the highest few in order
+	U16 weakest[WEAKEST_CELLS_SHOWN];
+	U16 highest[WEAKEST_CELLS_SHOWN];
+	U8 found = 0;
+	long sum = 0;
+	int known = 0;
+	for (U8 id=0; id<MAX_BMS_MODULES; id++)
+		for (U8 n=0; n<bmsCellCounts[id]; n++)
+		{
+			U16 index = id*CELLS_PER_MODULE + n;
+			cli(); // Updated by the RX poll
+			U16 r = cellResistance[index];
+			sei();
+			if (r == IR_UNKNOWN) continue;
+			sum += r;
+			known++;
+			U8 slot = found;
+			while (slot > 0 && highest[slot-1] < r) slot--;
+			if (slot >= WEAKEST_CELLS_SHOWN) continue;
+			if (found < WEAKEST_CELLS_SHOWN) found++;
+			for (U8 s=found-1; s>slot; s--)
+			{
+				highest[s] = highest[s-1];
+				weakest[s] = weakest[s-1];
+			}
+			highest[slot] = r;
+			weakest[slot] = index;
+		}
+	long average = known ? sum/known : 0;
+
+	if (known)
+		TFT_Number(average, 0, 2, 7, ALIGN_LEFT, PSTR(""), 90, 30, 1, TEXT_COLOUR, BGND_COLOUR);
+	else
+		TFT_Text_P(PSTR(" -     "), 90, 30, 1, TEXT_COLOUR, BGND_COLOUR);
+	TFT_Number(irSteps, 0, 0, 5, ALIGN_LEFT, PSTR(""), 250, 30, 1, TEXT_COLOUR, BGND_COLOUR);
+
+	for (U8 row=0; row<WEAKEST_CELLS_SHOWN; row++)
+	{
+		unsigned int y = 60 + row*22;
+		if (row >= found)
+		{
+			TFT_Box(16, y, 303, y+15, BGND_COLOUR);
+			continue;
+		}
+		strcpy_P(buffer, PSTR("Module "));
+		itoa(weakest[row]/CELLS_PER_MODULE, buffer+7, 10);
+		strcat_P(buffer, PSTR(" Cell "));
+		itoa(weakest[row]%CELLS_PER_MODULE + 1, buffer+strlen(buffer), 10);
+		strcat_P(buffer, PSTR("   "));
+		TFT_PropText(buffer, 16, y, LABEL_COLOUR, BGND_COLOUR);
+		TFT_Number(highest[row], 0, 2, 7, ALIGN_RIGHT, PSTR(""), 150, y, 1, TEXT_COLOUR, BGND_COLOUR);
+		long over = average ? (highest[row] - average)*100/average : 0; // Percent above average
+		if (over > 9999) over = 9999;
+		TFT_Number(over, 0, 0, 6, ALIGN_RIGHT, PSTR("%"), 234, y, 1, over >= 50 ? ORANGE : TEXT_COLOUR, BGND_COLOUR);
+	}
+}
+
+// Cells drifting away from their module or the pack, worst first
+void RenderCellDrift()
+{
+	bool learning = true;
+	for (U8 id=0; id<MAX_BMS_MODULES; id++)
+		if (driftSweeps[id] >= DRIFT_WARMUP) learning = false;
+
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("Cell Drift"));
+	}
+
+	if (learning)
+		strcpy_P(buffer, PSTR("Learning the pack...       "));
+	else if (numDriftAlerts == 0)
+		strcpy_P(buffer, PSTR("No cells drifting           "));
+	else
+		strcpy_P(buffer, PSTR("Drifting cells, worst first "));
+	TFT_PropText(buffer, 16, 30, LABEL_COLOUR, BGND_COLOUR);
+
+	for (U8 row=0; row<DRIFT_ALERTS; row++)
+	{
+		unsigned int y = 60 + row*22;
+		if (row >= numDriftAlerts)
+		{
+			TFT_Box(16, y, 303, y+15, BGND_COLOUR);
+			continue;
+		}
+		DriftAlert* a = &driftAlerts[row];
+		strcpy_P(buffer, PSTR("Module "));
+		itoa(a->module, buffer+7, 10);
+		strcat_P(buffer, PSTR(" Cell "));
+		itoa(a->cell, buffer+strlen(buffer), 10);
+		strcat_P(buffer, PSTR("   "));
+		TFT_PropText(buffer, 16, y, LABEL_COLOUR, BGND_COLOUR);
+		TFT_Number(a->deviation, 0, 0, 6, ALIGN_RIGHT, PSTR("mV"), 140, y, 1, a->fromPack ? ORANGE : TEXT_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(a->fromPack ? PSTR("vs pack    ") : PSTR("vs module"), 228, y, LABEL_COLOUR, BGND_COLOUR);
+	}
+}
+
+// A page of the event log, newest first. Only read from EEPROM when the page or the log changes
+void RenderEventLog()
+{
+	static U16 shownPage;
+	static U8 shownChanges;
+	bool fullRedraw = displayNeedsFullRedraw;
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("Event Log"));
+	}
+
+	if (fullRedraw || eventPage != shownPage || eventLogChanges != shownChanges)
+	{
+		shownChanges = eventLogChanges;
+		Event events[EVENTS_PER_PAGE];
+		U8 found = ReadEvents(eventPage*EVENTS_PER_PAGE, events, EVENTS_PER_PAGE);
+		if (found == 0 && eventPage > 0) // Gone past the oldest
+		{
+			eventPage--;
+			found = ReadEvents(eventPage*EVENTS_PER_PAGE, events, EVENTS_PER_PAGE);
+		}
+		shownPage = eventPage;
+
+		for (U8 row=0; row<EVENTS_PER_PAGE; row++)
+		{
+			unsigned int y = 28 + row*24;
+			TFT_Box(0, y, 319, y+17, BGND_COLOUR);
+			if (row >= found) continue;
+			Event* e = &events[row];
+
+			// When, as power up number and h:mm:ss since
+			U32 s = e->seconds;
+			buffer[0] = '#';
+			utoa(e->boot, buffer+1, 10);
+			strcat_P(buffer, PSTR(" "));
+			ultoa(s/3600, buffer+strlen(buffer), 10);
+			for (U8 n=0; n<2; n++)
+			{
+				U8 part = n ? s%60 : s/60%60;
+				strcat_P(buffer, (part < 10) ? PSTR(":0") : PSTR(":"));
+				itoa(part, buffer+strlen(buffer), 10);
+			}
+			TFT_PropText(buffer, 8, y, LABEL_COLOUR, BGND_COLOUR);
+
+			U16 colour = TEXT_COLOUR;
+			switch (e->kind)
+			{
+				case EVENT_POWER_ON:	strcpy_P(buffer, PSTR("Power on")); break;
+				case EVENT_BUS_OFF:		strcpy_P(buffer, PSTR("CAN bus off")); colour = ORANGE; break;
+				case EVENT_STATE:		strcpy_P(buffer, (char*)pgm_read_word(&(coreStatuses[e->value < 6 ? e->value : 0]))); break;
+				case EVENT_ERROR:
+					if (e->value == NO_ERROR)
+						strcpy_P(buffer, PSTR("Error cleared"));
+					else
+					{
+						strcpy_P(buffer, (char*)pgm_read_word(&(errorStrings[e->value < NUM_ERRORS ? e->value : 0])));
+						colour = RED;
+					}
+					break;
+				case EVENT_CHARGE_START:
+				case EVENT_CHARGE_END:
+					strcpy_P(buffer, (e->kind == EVENT_CHARGE_START) ? PSTR("Charge start ") : PSTR("Charge end "));
+					itoa(e->value, buffer+strlen(buffer), 10);
+					strcat_P(buffer, PSTR("%"));
+					colour = CHARGING_COLOUR;
+					break;
+			}
+			TFT_PropText(buffer, 120, y, colour, BGND_COLOUR);
+		}
+	}
+
+	RenderButton(&olderEventsButton, fullRedraw);
+	RenderButton(&newerEventsButton, fullRedraw);
+}
+
+// Share of the energy used that came back as regen, in percent
+static long RegenShare(EnergyTotals* t)
+{
+	return (t->whOut < 100) ? 0 : t->whRegen / (t->whOut/100);
+}
+
+void RenderTripComputer()
+{
+	static const char rowNames[5][12] PROGMEM = { "Used", "Charged", "Energy used", "Energy in", "Regen" };
+	bool labels = displayNeedsFullRedraw;
+	if (displayNeedsFullRedraw)
+	{
+		displayNeedsFullRedraw = false;
+		DrawTitlebar_P(PSTR("Trip Computer"));
+		TFT_PropText_P(PSTR("Trip"), 166, 30, LABEL_COLOUR, BGND_COLOUR);
+		TFT_PropText_P(PSTR("Lifetime"), 246, 30, LABEL_COLOUR, BGND_COLOUR);
+		for (U8 row=0; row<5; row++)
+		{
+			strcpy_P(buffer, rowNames[row]);
+			TFT_PropText(buffer, 16, 54+row*26, LABEL_COLOUR, BGND_COLOUR);
+		}
+	}
+
+	cli(); // Totals are updated by the RX poll
+	EnergyRecord r = energy;
+	sei();
+	for (U8 column=0; column<2; column++)
+	{
+		EnergyTotals* t = column ? &r.lifetime : &r.trip;
+		unsigned int x = 110 + column*104;
+		TFT_Number(t->ahOut, 1, 1, 8, ALIGN_RIGHT, PSTR("Ah"), x, 54, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(t->ahIn, 1, 1, 8, ALIGN_RIGHT, PSTR("Ah"), x, 80, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(t->whOut, 2, 1, 8, ALIGN_RIGHT, PSTR("kWh"), x, 106, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(t->whIn, 2, 1, 8, ALIGN_RIGHT, PSTR("kWh"), x, 132, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(RegenShare(t), 0, 0, 8, ALIGN_RIGHT, PSTR("%"), x, 158, 1, TEXT_COLOUR, BGND_COLOUR);
+	}
+	RenderButton(&resetTripButton, labels);
+}
+
 void RenderWarningOverlay()
 {
 	if (displayNeedsFullRedraw)
@@ -2193,7 +4343,8 @@ void RenderWarningOverlay()
 
 		strcpy_P(buffer, (char*)pgm_read_word(&(errorStrings[error])));
 	
-		TFT_CentredText("Warning:", 160, 90, 1, RED, BLACK);
+		TFT_Sprite(SPRITE_WARNING, 40, 84, 0);
+		TFT_CentredText_P(PSTR("Warning:"), 160, 90, 1, RED, BLACK);
 		TFT_CentredText(buffer, 160, 130, 1, TEXT_COLOUR, BLACK);
 	}
 }
@@ -2230,7 +4381,7 @@ void RenderOptionsButtons()
 
 static inline void RenderBorderBox(int lx, int ly, int rx, int ry, U16 Fcolor, U16 Bcolor)
 {
-	TFT_Box(lx, ly, rx, ry, Fcolor);
+	TFT_Frame(lx, ly, rx, ry, 2, Fcolor);
 	TFT_Box(lx+2, ly+2, rx-2, ry-2, Bcolor);
 }
 
@@ -2244,7 +4395,7 @@ void RenderButton(Button* button, bool needsRedraw)
 		U16 Bcolor = BLACK;
 		if (touchX > 0 && touchY > 0 && touched) Bcolor = button->colour;
 		RenderBorderBox(button->x-button->width/2, button->y, button->x+button->width/2, button->y+32, button->colour, Bcolor);
-		TFT_CentredText(button->text, button->x, button->y+8, 1, button->tcolour, Bcolor);
+		TFT_CentredText_P(button->text, button->x, button->y+8, 1, button->tcolour, Bcolor);
 		button->isTouched = touched;
 	}
 }
@@ -2258,93 +4409,77 @@ void RenderSettings()
 		fullRedraw = true;
 		
 		if (isBMS16)
-			DrawTitlebar("BMS Setup");
+			DrawTitlebar_P(PSTR("BMS Setup"));
 		else
-			DrawTitlebar("EVMS : Setup");
+			DrawTitlebar_P(PSTR("EVMS : Setup"));
 		
-		if (!isBMS16 || haveReceivedMCData) TFT_Text("<", 8, 30, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text("<", 8, 90, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text("<", 8, 150, 2, TEXT_COLOUR, BGND_COLOUR);
-		if (!isBMS16 || haveReceivedMCData) TFT_Text(">", 288, 30, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(">", 288, 90, 2, TEXT_COLOUR, BGND_COLOUR);
-		TFT_Text(">", 288, 150, 2, TEXT_COLOUR, BGND_COLOUR);	
+		if (!isBMS16 || haveReceivedMCData) TFT_LargeText_P(PSTR("<"), 8, 30, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR("<"), 8, 90, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR("<"), 8, 150, 2, TEXT_COLOUR, BGND_COLOUR);
+		if (!isBMS16 || haveReceivedMCData) TFT_LargeText_P(PSTR(">"), 288, 30, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR(">"), 288, 90, 2, TEXT_COLOUR, BGND_COLOUR);
+		TFT_LargeText_P(PSTR(">"), 288, 150, 2, TEXT_COLOUR, BGND_COLOUR);	
 	}
 
 	RenderButton(&exitSetupButton, fullRedraw);
 
 	if (settingsPage == PACK_SETUP)
 	{
-		TFT_CentredText("BMS Configuration", 160, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_CentredText("Module ID:", 160, 90, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_CentredText("Cell count:", 160, 150, 1, LABEL_COLOUR, BGND_COLOUR);
-
-		char temp[4];
-		itoa(currentBmsModule, temp, 10);
-		strcpy(buffer, "          "); // Blanking spaces either side in case change of length
-		strcat(buffer, temp);
-		strcat(buffer, "          ");
-		TFT_CentredText(buffer, 160, 110, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_CentredPropText_P(PSTR("BMS Configuration"), 160, 40, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredPropText_P(PSTR("Module ID:"), 160, 90, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredPropText_P(PSTR("Cell count:"), 160, 150, LABEL_COLOUR, BGND_COLOUR);
 
-		itoa(bmsCellCounts[currentBmsModule], temp, 10);
-		strcpy(buffer, "          ");
-		strcat(buffer, temp);
-		strcat(buffer, "          ");
-		TFT_CentredText(buffer, 160, 170, 1, TEXT_COLOUR, BGND_COLOUR);
+		// Blanking spaces either side in case change of length
+		TFT_Number(currentBmsModule, 0, 0, 22, ALIGN_CENTRE, PSTR(""), 160-22*6, 110, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_Number(bmsCellCounts[currentBmsModule], 0, 0, 22, ALIGN_CENTRE, PSTR(""), 160-22*6, 170, 1, TEXT_COLOUR, BGND_COLOUR);
 	}
 	else if (settingsPage == MC_SETTINGS)
 	{
-		TFT_CentredText(" Motor Controller ", 160, 40, 1, GREEN, BGND_COLOUR);
-		TFT_CentredText("Parameter:", 160, 90, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_CentredText("   Value:   ", 160, 150, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredText_P(PSTR(" Motor Controller "), 160, 40, 1, GREEN, BGND_COLOUR);
+		TFT_CentredPropText_P(PSTR("Parameter:"), 160, 90, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("   Value:   "), 160, 150, 1, LABEL_COLOUR, BGND_COLOUR);
 
-		TFT_CentredText(mcNames[mcCurrentParameter], 160, 110, 1, TEXT_COLOUR, BGND_COLOUR);
+		TFT_CentredText_P((const char*)pgm_read_word(&mcNames[mcCurrentParameter]), 160, 110, 1, TEXT_COLOUR, BGND_COLOUR);
 
 		int value = mcSettings[mcCurrentParameter];
 		if (mcCurrentParameter == MC_MAX_MOTOR_CURRENT || mcCurrentParameter == MC_MAX_BATT_CURRENT || mcCurrentParameter == MC_IDLE_CURRENT)
 			value *= 10;
 
 		if (mcCurrentParameter == MC_THROTTLE_TYPE)
-			strcpy(buffer, mcThrottleTypes[value]);
+			TFT_CentredText_P((const char*)pgm_read_word(&mcThrottleTypes[value]), 160, 170, 1, TEXT_COLOUR, BGND_COLOUR);
 		else if (mcCurrentParameter == MC_SPEED_CONTROL_TYPE || mcCurrentParameter == MC_TORQUE_CONTROL_TYPE)
-			strcpy(buffer, mcControlTypes[value]);
+			TFT_CentredText_P((const char*)pgm_read_word(&mcControlTypes[value]), 160, 170, 1, TEXT_COLOUR, BGND_COLOUR);
 		else
-		{
-			char temp[20];
-			itoa(value, temp, 10);
-		
-			strcpy(buffer, "      ");
-			strcat(buffer, temp);
-			strcat(buffer, mcUnits[mcCurrentParameter]);
-			strcat(buffer, "      ");
-		}
-		TFT_CentredText(buffer, 160, 170, 1, TEXT_COLOUR, BGND_COLOUR);
+			TFT_Number(value, 0, 0, 22, ALIGN_CENTRE, mcUnits[mcCurrentParameter], 160-22*6, 170, 1, TEXT_COLOUR, BGND_COLOUR);
 	}
 	else
 	{
-		TFT_CentredText(" General Settings ", 160, 40, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_CentredText("Parameter:", 160, 90, 1, LABEL_COLOUR, BGND_COLOUR);
-		TFT_CentredText("   Value:   ", 160, 150, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredText_P(PSTR(" General Settings "), 160, 40, 1, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredPropText_P(PSTR("Parameter:"), 160, 90, LABEL_COLOUR, BGND_COLOUR);
+		TFT_CentredText_P(PSTR("   Value:   "), 160, 150, 1, LABEL_COLOUR, BGND_COLOUR);
 
 		char temp[20];
 		strcpy_P(temp, (char*)pgm_read_word(&(generalSettingsLabels[currentParameter])));
 		
 		// Couple of reassigned settings for BMS16
-		if (isBMS16 && currentParameter == NUM_CELLS) strcpy(temp, "  Num Cells  ");
-		if (isBMS16 && currentParameter == SHUNT_SIZE) strcpy(temp, "  Shunt Size  ");
+		if (isBMS16 && currentParameter == NUM_CELLS) strcpy_P(temp, PSTR("  Num Cells  "));
+		if (isBMS16 && currentParameter == SHUNT_SIZE) strcpy_P(temp, PSTR("  Shunt Size  "));
 		
-		strcpy(buffer, " ");
+		strcpy_P(buffer, PSTR(" "));
 		strcat(buffer, temp);
-		strcat(buffer, " "); // White space to clean up previous label if longer
+		strcat_P(buffer, PSTR(" ")); // White space to clean up previous label if longer
 		TFT_CentredText(buffer, 160, 110, 1, TEXT_COLOUR, BGND_COLOUR);
 
 		int value = 0;
-		char* units = allSettingsUnits[currentParameter];
-		if (maximums[currentParameter] == 1) // It's a Yes/No one
+		bool isNumber = false; // Otherwise the value's text is in temp
+		char decimals = 0;
+		const char* units = allSettingsUnits[currentParameter]; // In flash
+		if (pgm_read_byte(&maximums[currentParameter]) == 1) // It's a Yes/No one
 		{
 			if (settings[currentParameter] == 1)
-				strcpy(temp, "YES");
+				strcpy_P(temp, PSTR("YES"));
 			else
-				strcpy(temp, "NO");
+				strcpy_P(temp, PSTR("NO"));
 		}
 		else
 		{
@@ -2368,63 +4503,89 @@ void RenderSettings()
 			if (currentParameter == CHARGER_VOLTAGE || currentParameter == CHARGER_VOLTAGE2
 				|| currentParameter == FULL_VOLTAGE) value *= PACK_VOLTAGE_MULTIPLIER;
 			
-			if (*units == 'C' && settings[USE_FAHRENHEIT])
+			if (pgm_read_byte(units) == 'C' && settings[USE_FAHRENHEIT])
 			{
 				value = value*9/5+32;
-				units = "F";
+				units = PSTR("F");
 			}
 
-			itoa(value, temp, 10);
+			isNumber = true;
 			if (currentParameter == BMS_MIN_VOLTAGE || currentParameter == BMS_MAX_VOLTAGE
 				|| currentParameter == BMS_HYSTERESIS || currentParameter == BALANCE_VOLTAGE)
-				AddDecimalPoint2(temp);
+				decimals = 2;
+			if (currentParameter == PACK_SUMMARY_PERIOD) decimals = 1;
 		}
 
 		if (((currentParameter == CURRENT_WARNING || currentParameter == CURRENT_TRIP) && value > 1200)
 			|| (currentParameter == FULL_VOLTAGE && value == 0) || (currentParameter == MIN_AUX_VOLTAGE && value == 0)
 			|| (currentParameter == OVER_TEMP && value == 151) || (currentParameter == BMS_MIN_TEMP && value == -40)
 			|| (currentParameter == BMS_MAX_TEMP && value == 101) || (currentParameter == CAN_POWER_DOWN_DELAY && value == 6)
-			|| (currentParameter == BALANCE_VOLTAGE && value == 452))
+			|| (currentParameter == BALANCE_VOLTAGE && value == 452) || (currentParameter == BMS_POLL_LOAD && value == 0)
+			|| (currentParameter == PACK_SUMMARY_PERIOD && value == 0))
 		{
-			strcpy(temp, "OFF");
-			units = "";
+			strcpy_P(temp, PSTR("OFF"));
+			units = PSTR("");
+			isNumber = false;
 		}
 
 		if (currentParameter == BALANCE_VOLTAGE && value == 451)
 		{
-			strcpy(temp, "Dynamic");
-			units = "";
+			strcpy_P(temp, PSTR("Dynamic"));
+			units = PSTR("");
+			isNumber = false;
 		}
 
-		if (currentParameter == MPI_FUNCTION) strcpy_P(temp, (char*)pgm_read_word(&(mpiStrings[value])));
+		if (currentParameter == MPI_FUNCTION)
+		{
+			strcpy_P(temp, (char*)pgm_read_word(&(mpiStrings[value])));
+			isNumber = false;
+		}
 		if (currentParameter == MPO1_FUNCTION || currentParameter == MPO2_FUNCTION)
+		{
 			strcpy_P(temp, (char*)pgm_read_word(&(mpoStrings[value])));
+			isNumber = false;
+		}
 
 		if (currentParameter == SOC_DISPLAY)
 		{
-			if (settings[currentParameter] == SOC_PERCENT) strcpy(temp, "Percent");
-			else strcpy(temp, "Amp-hours");
+			if (settings[currentParameter] == SOC_PERCENT) strcpy_P(temp, PSTR("Percent"));
+			else strcpy_P(temp, PSTR("Amp-hours"));
+			isNumber = false;
+		}
+
+		if (currentParameter == CAN_SPEED)
+		{
+			static const char canSpeedStrings[5][5] PROGMEM = { "Auto", "125k", "250k", "500k", "1M" };
+			strcpy_P(temp, canSpeedStrings[value]);
+			isNumber = false;
 		}
 
-		if (isBMS16 && currentParameter == NUM_CELLS) units = "";
+		if (isBMS16 && currentParameter == NUM_CELLS) units = PSTR("");
 		if (isBMS16 && currentParameter == SHUNT_SIZE)
 		{
-			units = "";
-			char* shuntStrings[4] = { "None", "100A", "200A", "500A" };
+			units = PSTR("");
+			static const char shuntStrings[4][5] PROGMEM = { "None", "100A", "200A", "500A" };
 			if (value > 3) value = 3;
-			strcpy(temp, shuntStrings[value]);
+			strcpy_P(temp, shuntStrings[value]);
+			isNumber = false;
+		}
+
+		if (isNumber) // Numbers are padded out to a fixed field, so no need to work out blanking spaces
+		{
+			TFT_Number(value, 0, decimals, 22, ALIGN_CENTRE, units, 160-22*6, 170, 1, TEXT_COLOUR, BGND_COLOUR);
+			return;
 		}
 
 		if (currentParameter == NUM_PARALLEL_STRINGS)
-			strcpy(buffer, "     "); // Need extra space because it's so short compared with previous label
+			strcpy_P(buffer, PSTR("     ")); // Need extra space because it's so short compared with previous label
 		else
-			strcpy(buffer, "    ");
+			strcpy_P(buffer, PSTR("    "));
 		strcat(buffer, temp);
-		strcat(buffer, units);
+		strcat_P(buffer, units);
 		if (currentParameter == NUM_PARALLEL_STRINGS)
-			strcat(buffer, "     ");
+			strcat_P(buffer, PSTR("     "));
 		else
-			strcat(buffer, "    ");
+			strcat_P(buffer, PSTR("    "));
 
 		TFT_CentredText(buffer, 160, 170, 1, TEXT_COLOUR, BGND_COLOUR);
 	}	
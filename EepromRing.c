@@ -0,0 +1,167 @@
+// EepromRing.c
+// Wear-levelled storage of fixed size records in a ring of EEPROM slots
+// For AT90CAN64/128 microcontrollers. See EepromRing.h for the layout.
+
+#include "EepromRing.h"
+
+#include <avr/eeprom.h>
+
+#define CHECKSUM_SEED	0x5A
+#define ERASED_SEQ		0xFFFF // Never written, so a blank slot never checks out
+#define SEQ_MASK		0x7FFF // Sequence numbers count in 15 bits, so they never reach ERASED_SEQ
+
+static inline U8* SlotAddress(EepromRing* ring, U8 slot)
+{
+	return (U8*)(ring->base + slot*EEPROM_RING_SLOT_SIZE(ring->recordSize));
+}
+
+static U8 Checksum(U16 seq, const U8* record, U8 size)
+{
+	U8 sum = CHECKSUM_SEED + (seq & 0xFF) + (seq >> 8);
+	for (U8 i=0; i<size; i++) sum += record[i];
+	return sum;
+}
+
+// Sum of a slot's sequence number and record as they are in EEPROM, copying the record out if asked
+static U8 SlotSum(EepromRing* ring, U8 slot, U16* seq, U8* record)
+{
+	U8* p = SlotAddress(ring, slot);
+	*seq = eeprom_read_word((uint16_t*)p);
+	U8 sum = CHECKSUM_SEED + (*seq & 0xFF) + (*seq >> 8);
+	for (U8 i=0; i<ring->recordSize; i++)
+	{
+		U8 b = eeprom_read_byte(p+2+i);
+		if (record) record[i] = b;
+		sum += b;
+	}
+	return sum;
+}
+
+// Reads a slot into record (if not null) and its sequence number into seq. Returns 1 if it's valid
+static U8 ReadSlot(EepromRing* ring, U8 slot, U16* seq, U8* record)
+{
+	U8 sum = SlotSum(ring, slot, seq, record);
+	return *seq != ERASED_SEQ && sum == eeprom_read_byte(SlotAddress(ring, slot)+2+ring->recordSize);
+}
+
+// Sequence numbers of valid records are never more than slots apart, so the newest is simply the
+// highest, allowing for wrap around
+void EepromRingInit(EepromRing* ring, U16 base, U8 recordSize, U8 slots)
+{
+	ring->base = base;
+	ring->recordSize = recordSize;
+	ring->slots = slots;
+	ring->count = 0;
+	ring->pending = 0;
+
+	for (U8 slot=0; slot<slots; slot++)
+	{
+		U16 seq;
+		if (!ReadSlot(ring, slot, &seq, 0)) continue;
+		if (ring->count++ == 0 || ((seq - ring->seq) & SEQ_MASK) < SEQ_MASK/2)
+		{
+			ring->newest = slot;
+			ring->seq = seq;
+		}
+	}
+}
+
+static inline U8 NextSlot(EepromRing* ring)
+{
+	U8 slot = ring->count ? ring->newest+1 : 0;
+	return (slot == ring->slots) ? 0 : slot;
+}
+
+static inline U16 NextSeq(EepromRing* ring)
+{
+	return ring->count ? (ring->seq+1) & SEQ_MASK : 0;
+}
+
+static void Written(EepromRing* ring, U8 slot, U16 seq)
+{
+	ring->newest = slot;
+	ring->seq = seq;
+	if (ring->count < ring->slots) ring->count++;
+}
+
+void EepromRingWrite(EepromRing* ring, const void* record)
+{
+	U8 slot = NextSlot(ring);
+	U16 seq = NextSeq(ring);
+
+	U8* p = SlotAddress(ring, slot);
+	eeprom_write_byte(p+2+ring->recordSize, ~Checksum(seq, record, ring->recordSize)); // Invalid until finished
+	eeprom_update_word((uint16_t*)p, seq);
+	eeprom_update_block(record, p+2, ring->recordSize);
+	eeprom_write_byte(p+2+ring->recordSize, Checksum(seq, record, ring->recordSize));
+	eeprom_write_byte(0, 0); // Park EEPROM pointer at sacrificial location 0
+	Written(ring, slot, seq);
+}
+
+void EepromRingWriteLater(EepromRing* ring, const void* record)
+{
+	ring->pending = record;
+	ring->step = 0;
+	ring->pendingSum = Checksum(NextSeq(ring), record, ring->recordSize);
+}
+
+// Same order as EepromRingWrite(): spoil the checksum, sequence number and record (only the bytes that
+// change), checksum, park. Steps are bytes of the slot, plus one for parking
+void EepromRingPoll(EepromRing* ring)
+{
+	if (!ring->pending || !eeprom_is_ready()) return;
+
+	U8 slot = NextSlot(ring);
+	U16 seq = NextSeq(ring);
+	U8* p = SlotAddress(ring, slot);
+	U8 sumStep = 3 + ring->recordSize;
+	while (ring->step <= sumStep)
+	{
+		U8 step = ring->step++;
+		U8* address;
+		U8 value;
+		if (step == 0 || step == sumStep)
+		{
+			address = p+2+ring->recordSize;
+			value = (step == 0) ? ~ring->pendingSum : ring->pendingSum;
+		}
+		else if (step <= 2)
+		{
+			address = p+step-1;
+			value = (step == 1) ? seq : seq>>8;
+		}
+		else
+		{
+			address = p+step-1;
+			value = ring->pending[step-3];
+		}
+		if (step == 0 || step == sumStep || eeprom_read_byte(address) != value)
+		{
+			eeprom_write_byte(address, value); // Ready, so this just starts it
+			return;
+		}
+	}
+	eeprom_write_byte(0, 0);
+	Written(ring, slot, seq);
+	ring->pending = 0;
+}
+
+U8 EepromRingRead(EepromRing* ring, U8 age, void* record)
+{
+	if (age >= ring->count) return 0;
+	U8 slot = (ring->newest >= age) ? ring->newest-age : ring->newest+ring->slots-age;
+	U16 seq;
+	return ReadSlot(ring, slot, &seq, record) && ((ring->seq - seq) & SEQ_MASK) == age; // Not left over from an older lap
+}
+
+void EepromRingClear(EepromRing* ring)
+{
+	for (U8 slot=0; slot<ring->slots; slot++)
+	{
+		U16 seq;
+		U8 sum = SlotSum(ring, slot, &seq, 0);
+		eeprom_update_byte(SlotAddress(ring, slot)+2+ring->recordSize, ~sum); // Can't check out
+	}
+	eeprom_write_byte(0, 0);
+	ring->count = 0;
+}
@@ -0,0 +1,40 @@
+// EepromRing.h
+// Wear-levelled storage of fixed size records in a ring of EEPROM slots
+// For AT90CAN64/128 microcontrollers
+//
+// Each write goes to the slot after the last one, so every slot wears at 1/slots of the rate of a
+// fixed location. Slots hold a sequence number, the record and a checksum, and the newest is found
+// at start up as the valid slot with the highest sequence number. A write
+// that's cut short by a power loss fails its checksum and the previous record is used instead.
+// EepromRingWrite() busy-waits on the EEPROM (about 3.4ms a byte that changes), so call it from the main
+// loop only. EepromRingWriteLater() does the same write in the background instead, a byte per
+// EepromRingPoll() whenever the EEPROM is ready, and never waits.
+
+#ifndef EEPROM_RING_H
+#define EEPROM_RING_H
+
+#include "config.h"
+
+typedef struct {
+	U16 base; // EEPROM address of the first slot
+	U8 recordSize;
+	U8 slots;
+	U8 newest; // Slot holding the newest record, only meaningful if count > 0
+	U8 count; // Valid records, up to slots
+	U16 seq; // Sequence number of the newest
+	const U8* pending; // Record being written by EepromRingPoll(), 0 if none
+	U8 step; // Next byte of the slot it writes
+	U8 pendingSum;
+} EepromRing;
+
+#define EEPROM_RING_SLOT_SIZE(recordSize)	((recordSize) + 3) // Sequence number and checksum
+
+void EepromRingInit(EepromRing* ring, U16 base, U8 recordSize, U8 slots);
+void EepromRingWrite(EepromRing* ring, const void* record);
+void EepromRingWriteLater(EepromRing* ring, const void* record); // Record must stay put until it's done
+void EepromRingPoll(EepromRing* ring);
+static inline U8 EepromRingBusy(EepromRing* ring) { return ring->pending != 0; }
+U8 EepromRingRead(EepromRing* ring, U8 age, void* record); // age 0 is the newest. Returns 0 if there isn't one that old
+void EepromRingClear(EepromRing* ring);
+
+#endif
@@ -0,0 +1,198 @@
+// IsoTp.c
+// ISO 15765-2 style segmentation of messages up to 4095 bytes over CAN, with flow control
+// For AT90CAN64/128 microcontrollers, on top of can_lib. See IsoTp.h for how it's driven.
+
+#include "IsoTp.h"
+
+#include <string.h>
+
+enum { SINGLE_FRAME, FIRST_FRAME, CONSECUTIVE_FRAME, FLOW_CONTROL }; // Top nibble of the first byte
+enum { FC_CONTINUE, FC_WAIT, FC_OVERFLOW };
+#define NO_FC	0xFF
+
+void IsoTpInit(IsoTpLink* link, long txId, long rxId, U8 extended, U8* rxBuffer, U16 rxSize)
+{
+	memset(link, 0, sizeof(IsoTpLink));
+	link->txId = txId;
+	link->rxId = rxId;
+	link->extended = extended;
+	link->rxBuffer = rxBuffer;
+	link->rxSize = rxSize;
+	link->fcPending = NO_FC;
+}
+
+U8 IsoTpSend(IsoTpLink* link, const U8* data, U16 length)
+{
+	if (link->txState == ISOTP_BUSY || length == 0 || length > ISOTP_MAX_LENGTH) return 0;
+
+	link->txBuffer = data;
+	link->txLength = length;
+	link->txPos = 0;
+	link->txSeq = 0;
+	link->txGap = 0;
+	link->txWaitingForFc = 0;
+	link->txState = ISOTP_BUSY; // Last, IsoTpPoll() doesn't look at the rest until this is set
+	return 1;
+}
+
+U8 IsoTpFrameReceived(IsoTpLink* link, long id, const U8* data, U8 length)
+{
+	if (id != link->rxId || length == 0) return 0;
+
+	switch (data[0] >> 4)
+	{
+		case SINGLE_FRAME:
+		{
+			U8 n = data[0] & 0x0F;
+			if (link->rxState == ISOTP_DONE || n == 0 || n >= length || n > link->rxSize) break; // Busy or malformed
+			memcpy(link->rxBuffer, data+1, n);
+			link->rxLength = n;
+			link->rxState = ISOTP_DONE;
+			break;
+		}
+
+		case FIRST_FRAME:
+		{
+			U16 total = ((data[0] & 0x0F) << 8) | data[1];
+			if (length < 8 || total < 8) break;
+			if (link->rxState == ISOTP_DONE || total > link->rxSize) // Nowhere to put it, so tell the sender to give up
+			{
+				link->fcPending = FC_OVERFLOW;
+				break;
+			}
+			memcpy(link->rxBuffer, data+2, 6);
+			link->rxLength = total;
+			link->rxPos = 6;
+			link->rxSeq = 1;
+			link->rxBlockLeft = link->blockSize;
+			link->rxTimer = ISOTP_TIMEOUT;
+			link->rxState = ISOTP_BUSY;
+			link->fcPending = FC_CONTINUE;
+			break;
+		}
+
+		case CONSECUTIVE_FRAME:
+		{
+			if (link->rxState != ISOTP_BUSY) break;
+			U16 n = link->rxLength - link->rxPos;
+			if (n > 7) n = 7;
+			if ((data[0] & 0x0F) != link->rxSeq || length < n+1) // Lost one, the whole message is gone
+			{
+				link->rxState = ISOTP_IDLE;
+				break;
+			}
+			memcpy(link->rxBuffer + link->rxPos, data+1, n);
+			link->rxPos += n;
+			link->rxSeq = (link->rxSeq+1) & 0x0F;
+			link->rxTimer = ISOTP_TIMEOUT;
+			if (link->rxPos == link->rxLength)
+				link->rxState = ISOTP_DONE;
+			else if (link->blockSize && --link->rxBlockLeft == 0)
+			{
+				link->rxBlockLeft = link->blockSize;
+				link->fcPending = FC_CONTINUE;
+			}
+			break;
+		}
+
+		case FLOW_CONTROL:
+			if (link->txState != ISOTP_BUSY || !link->txWaitingForFc || length < 3) break;
+			switch (data[0] & 0x0F)
+			{
+				case FC_CONTINUE:
+					link->txWaitingForFc = 0;
+					link->txBlockLeft = data[1];
+					// 0xF1-0xF9 are 100-900us, which our 1ms poll can't do any better than 1ms anyway
+					if (data[2] <= 127) link->txStMin = data[2];
+					else if (data[2] >= 0xF1 && data[2] <= 0xF9) link->txStMin = 1;
+					else link->txStMin = 127;
+					link->txGap = 0;
+					break;
+				case FC_WAIT:
+					link->txTimer = ISOTP_TIMEOUT;
+					break;
+				default:
+					link->txState = ISOTP_ERROR;
+			}
+			break;
+	}
+	return 1;
+}
+
+// Pads the frame out and hands it to a free MOB. Returns 0 if there wasn't one
+static U8 IsoTpSendFrame(IsoTpLink* link, U8 length)
+{
+	for (U8 n=length; n<8; n++) link->txFrame[n] = ISOTP_PADDING;
+
+	link->txCmd.pt_data = link->txFrame;
+	link->txCmd.ctrl.ide = link->extended;
+	if (link->extended) link->txCmd.id.ext = link->txId;
+	else link->txCmd.id.std = link->txId;
+	link->txCmd.dlc = 8;
+	link->txCmd.cmd = CMD_TX_DATA;
+	if (can_cmd(&link->txCmd) != CAN_CMD_ACCEPTED) return 0;
+
+	link->frameBusy = 1;
+	return 1;
+}
+
+void IsoTpPoll(IsoTpLink* link)
+{
+	if (link->rxState == ISOTP_BUSY && --link->rxTimer == 0) link->rxState = ISOTP_IDLE; // Sender went quiet
+	if (link->txState == ISOTP_BUSY && link->txWaitingForFc && --link->txTimer == 0) link->txState = ISOTP_ERROR;
+	if (link->txGap) link->txGap--;
+
+	if (link->frameBusy) // One frame on the bus at a time
+	{
+		U8 status = can_get_status(&link->txCmd);
+		if (status == CAN_STATUS_NOT_COMPLETED) return;
+		link->frameBusy = 0;
+		if (status == CAN_STATUS_ERROR && link->txState == ISOTP_BUSY) link->txState = ISOTP_ERROR;
+	}
+
+	U8* f = link->txFrame;
+	if (link->fcPending != NO_FC) // Flow control goes first, the other end is waiting on it
+	{
+		f[0] = FLOW_CONTROL<<4 | link->fcPending;
+		f[1] = link->blockSize;
+		f[2] = link->stMin;
+		if (IsoTpSendFrame(link, 3)) link->fcPending = NO_FC;
+		return;
+	}
+
+	if (link->txState != ISOTP_BUSY || link->txWaitingForFc || link->txGap) return;
+
+	U8 header = 1;
+	U16 n = link->txLength - link->txPos;
+	if (link->txPos == 0 && n <= 7)
+		f[0] = SINGLE_FRAME<<4 | n;
+	else if (link->txPos == 0)
+	{
+		f[0] = FIRST_FRAME<<4 | (n >> 8);
+		f[1] = n & 0xFF;
+		header = 2;
+		n = 6;
+	}
+	else
+	{
+		f[0] = CONSECUTIVE_FRAME<<4 | link->txSeq;
+		if (n > 7) n = 7;
+	}
+	memcpy(f+header, link->txBuffer + link->txPos, n);
+	if (!IsoTpSendFrame(link, header+n)) return; // Try again next time
+
+	link->txPos += n;
+	if (link->txPos == link->txLength)
+	{
+		link->txState = ISOTP_DONE;
+		return;
+	}
+	link->txSeq = (link->txSeq+1) & 0x0F;
+	if (header == 2 || (link->txBlockLeft && --link->txBlockLeft == 0))
+	{
+		link->txWaitingForFc = 1;
+		link->txTimer = ISOTP_TIMEOUT;
+	}
+	else
+		link->txGap = link->txStMin;
+}
@@ -0,0 +1,54 @@
+// IsoTp.h
+// ISO 15765-2 style segmentation of messages up to 4095 bytes over CAN, with flow control
+// For AT90CAN64/128 microcontrollers, on top of can_lib
+//
+// Nothing here blocks. IsoTpFrameReceived() is fed frames from the RX poll, IsoTpPoll() is called from the
+// same place at about 1kHz and sends at most one frame per call, using its own MOB through can_cmd().
+// Only call these while no other code is using the CAN registers (i.e not while CanTX() is running).
+
+#ifndef ISOTP_H
+#define ISOTP_H
+
+#include "config.h"
+#include "can_lib.h"
+
+#define ISOTP_MAX_LENGTH	4095
+#define ISOTP_TIMEOUT		1000 // ms to wait for a flow control or the next consecutive frame (N_Bs, N_Cr)
+#define ISOTP_PADDING		0xCC
+
+enum { ISOTP_IDLE, ISOTP_BUSY, ISOTP_DONE, ISOTP_ERROR };
+
+typedef struct {
+	long txId, rxId;
+	U8 extended; // 29-bit IDs
+	U8 blockSize; // Frames we let the other end send between our flow controls, 0 = no limit
+	U8 stMin; // ms we ask the other end to leave between frames
+
+	// Receiving
+	U8* rxBuffer;
+	U16 rxSize;
+	U16 rxLength, rxPos;
+	U8 rxSeq, rxBlockLeft;
+	U16 rxTimer;
+	volatile U8 rxState; // ISOTP_DONE holds the message until IsoTpRelease()
+
+	// Sending
+	const U8* txBuffer;
+	U16 txLength, txPos;
+	U8 txSeq, txBlockLeft, txStMin, txGap, txWaitingForFc;
+	U16 txTimer;
+	volatile U8 txState;
+
+	U8 fcPending; // Flow control status to send, or 0xFF for none
+	U8 frameBusy; // txCmd is out on the bus
+	st_cmd_t txCmd;
+	U8 txFrame[8];
+} IsoTpLink;
+
+void IsoTpInit(IsoTpLink* link, long txId, long rxId, U8 extended, U8* rxBuffer, U16 rxSize);
+U8 IsoTpSend(IsoTpLink* link, const U8* data, U16 length); // Returns 0 if already sending or too long
+U8 IsoTpFrameReceived(IsoTpLink* link, long id, const U8* data, U8 length); // Returns 1 if it was for us
+void IsoTpPoll(IsoTpLink* link);
+static inline void IsoTpRelease(IsoTpLink* link) { link->rxState = ISOTP_IDLE; }
+
+#endif
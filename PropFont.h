@@ -0,0 +1,160 @@
+// PropFont.h
+// Cropped, bit-packed proportional version of FONT_16x16, used by TFT_PropText()
+// GENERATED by tools/fontgen.py from Fonts.h - edit the generator or source font, not this file
+// 475 bytes of metrics + 1186 bytes of bitmaps (FONT_16x16 is 3040 bytes)
+
+#define PROP_FONT_FIRST		32
+#define PROP_FONT_COUNT		95
+#define PROP_FONT_HEIGHT	16
+
+// Per glyph: offset lo, offset hi, top<<4 | (rows-1), cols<<4 | left bearing, advance
+const unsigned char PROP_FONT_METRICS[95][5] PROGMEM = {
+	{ 0x00,0x00, 0x00, 0x00,  5 }, // <Space>
+	{ 0x00,0x00, 0x2C, 0x51,  7 }, // !
+	{ 0x09,0x00, 0x14, 0x91, 11 }, // "
+	{ 0x0F,0x00, 0x1D, 0xC1, 14 }, // #
+	{ 0x24,0x00, 0x1D, 0xA1, 12 }, // $
+	{ 0x36,0x00, 0x39, 0x81, 10 }, // %
+	{ 0x40,0x00, 0x2B, 0xA1, 12 }, // &
+	{ 0x4F,0x00, 0x23, 0x41,  6 }, // '
+	{ 0x51,0x00, 0x2B, 0x81, 10 }, // (
+	{ 0x5D,0x00, 0x2B, 0x81, 10 }, // )
+	{ 0x69,0x00, 0x2B, 0xC1, 14 }, // *
+	{ 0x7B,0x00, 0x47, 0x81, 10 }, // +
+	{ 0x83,0x00, 0xB3, 0x41,  6 }, // ,
+	{ 0x85,0x00, 0x71, 0xA1, 12 }, // -
+	{ 0x88,0x00, 0xB2, 0x31,  5 }, // .
+	{ 0x8A,0x00, 0x3A, 0xB1, 13 }, // /
+	{ 0x9A,0x00, 0x2B, 0xA1, 13 }, // 0
+	{ 0xA9,0x00, 0x2B, 0x92, 13 }, // 1
+	{ 0xB7,0x00, 0x2B, 0xA1, 13 }, // 2
+	{ 0xC6,0x00, 0x2B, 0xA1, 13 }, // 3
+	{ 0xD5,0x00, 0x2B, 0xA1, 13 }, // 4
+	{ 0xE4,0x00, 0x2B, 0xA1, 13 }, // 5
+	{ 0xF3,0x00, 0x2B, 0xA1, 13 }, // 6
+	{ 0x02,0x01, 0x2B, 0xB1, 13 }, // 7
+	{ 0x13,0x01, 0x2B, 0xA1, 13 }, // 8
+	{ 0x22,0x01, 0x2B, 0xA1, 13 }, // 9
+	{ 0x31,0x01, 0x47, 0x31,  5 }, // :
+	{ 0x34,0x01, 0x48, 0x41,  6 }, // ;
+	{ 0x39,0x01, 0x1D, 0x91, 11 }, // <
+	{ 0x49,0x01, 0x55, 0xC1, 14 }, // =
+	{ 0x52,0x01, 0x1D, 0x91, 11 }, // >
+	{ 0x62,0x01, 0x1D, 0xA1, 12 }, // ?
+	{ 0x74,0x01, 0x1D, 0xB1, 13 }, // @
+	{ 0x88,0x01, 0x2B, 0xA1, 12 }, // A
+	{ 0x97,0x01, 0x2B, 0xA1, 12 }, // B
+	{ 0xA6,0x01, 0x2B, 0xA1, 12 }, // C
+	{ 0xB5,0x01, 0x2B, 0xA1, 12 }, // D
+	{ 0xC4,0x01, 0x2B, 0xA1, 12 }, // E
+	{ 0xD3,0x01, 0x2B, 0xA1, 12 }, // F
+	{ 0xE2,0x01, 0x2B, 0xA1, 12 }, // G
+	{ 0xF1,0x01, 0x2B, 0x91, 11 }, // H
+	{ 0xFF,0x01, 0x2B, 0x71,  9 }, // I
+	{ 0x0A,0x02, 0x2B, 0xC1, 14 }, // J
+	{ 0x1C,0x02, 0x2B, 0xA1, 12 }, // K
+	{ 0x2B,0x02, 0x2B, 0xA1, 12 }, // L
+	{ 0x3A,0x02, 0x2B, 0xB1, 13 }, // M
+	{ 0x4B,0x02, 0x2B, 0xB1, 13 }, // N
+	{ 0x5C,0x02, 0x2B, 0xB1, 13 }, // O
+	{ 0x6D,0x02, 0x2B, 0xA1, 12 }, // P
+	{ 0x7C,0x02, 0x2C, 0xB1, 13 }, // Q
+	{ 0x8E,0x02, 0x2B, 0xA1, 12 }, // R
+	{ 0x9D,0x02, 0x2B, 0xA1, 12 }, // S
+	{ 0xAC,0x02, 0x2B, 0xB1, 13 }, // T
+	{ 0xBD,0x02, 0x2B, 0x91, 11 }, // U
+	{ 0xCB,0x02, 0x2B, 0x91, 11 }, // V
+	{ 0xD9,0x02, 0x2B, 0xB1, 13 }, // W
+	{ 0xEA,0x02, 0x2B, 0x91, 11 }, // X
+	{ 0xF8,0x02, 0x2B, 0x91, 11 }, // Y
+	{ 0x06,0x03, 0x2B, 0xA1, 12 }, // Z
+	{ 0x15,0x03, 0x2B, 0x71,  9 }, // [
+	{ 0x20,0x03, 0x2B, 0xB1, 13 }, // <Backslash>
+	{ 0x31,0x03, 0x2B, 0x71,  9 }, // ]
+	{ 0x3C,0x03, 0x14, 0xA1, 12 }, // ^
+	{ 0x43,0x03, 0xE1, 0xC1, 14 }, // _
+	{ 0x46,0x03, 0x23, 0x51,  7 }, // `
+	{ 0x49,0x03, 0x67, 0xA1, 12 }, // a
+	{ 0x53,0x03, 0x2B, 0xA1, 12 }, // b
+	{ 0x62,0x03, 0x67, 0x91, 11 }, // c
+	{ 0x6B,0x03, 0x2B, 0xA1, 12 }, // d
+	{ 0x7A,0x03, 0x67, 0x91, 11 }, // e
+	{ 0x83,0x03, 0x2B, 0x91, 11 }, // f
+	{ 0x91,0x03, 0x69, 0xA1, 12 }, // g
+	{ 0x9E,0x03, 0x2B, 0xA1, 12 }, // h
+	{ 0xAD,0x03, 0x2B, 0x91, 11 }, // i
+	{ 0xBB,0x03, 0x2D, 0x91, 11 }, // j
+	{ 0xCB,0x03, 0x2B, 0xA1, 12 }, // k
+	{ 0xDA,0x03, 0x2B, 0x91, 11 }, // l
+	{ 0xE8,0x03, 0x67, 0xB1, 13 }, // m
+	{ 0xF3,0x03, 0x67, 0x91, 11 }, // n
+	{ 0xFC,0x03, 0x67, 0x91, 11 }, // o
+	{ 0x05,0x04, 0x69, 0xA1, 12 }, // p
+	{ 0x12,0x04, 0x69, 0xA1, 12 }, // q
+	{ 0x1F,0x04, 0x67, 0xA1, 12 }, // r
+	{ 0x29,0x04, 0x67, 0x91, 11 }, // s
+	{ 0x32,0x04, 0x3A, 0x91, 11 }, // t
+	{ 0x3F,0x04, 0x67, 0xA1, 12 }, // u
+	{ 0x49,0x04, 0x67, 0x91, 11 }, // v
+	{ 0x52,0x04, 0x67, 0xB1, 13 }, // w
+	{ 0x5D,0x04, 0x67, 0x81, 10 }, // x
+	{ 0x65,0x04, 0x69, 0xA1, 12 }, // y
+	{ 0x72,0x04, 0x67, 0x81, 10 }, // z
+	{ 0x7A,0x04, 0x2B, 0xA1, 12 }, // {
+	{ 0x89,0x04, 0x1D, 0x31,  5 }, // |
+	{ 0x8F,0x04, 0x2B, 0xA1, 12 }, // }
+	{ 0x9E,0x04, 0x24, 0x61,  8 }  // ~ (degrees sign)
+};
+
+const unsigned char PROP_FONT_BITS[1186] PROGMEM = {
+	0x7C,0x07,0xF9,0xFF,0xCF,0xFE,0x77,0xC0,0x00,0xF7,0xFE,0x00,0x03,0xFF,0xF0,0x18,0x60,0x61,0x8F,0xFF,0xFF,0xFF,0x18,0x60,
+	0x61,0x81,0x86,0x06,0x18,0xFF,0xFF,0xFF,0xF1,0x86,0x06,0x18,0x1E,0x30,0xFC,0xC3,0x33,0x3F,0xFF,0x33,0x30,0xCC,0xCF,0xFF,
+	0xCC,0xCC,0x33,0xF0,0xC7,0x80,0xE1,0xF8,0xEE,0x70,0x38,0x1C,0x0E,0x77,0x1F,0x87,0x71,0xEF,0xFF,0x8E,0x18,0xE1,0xFF,0x37,
+	0x3F,0x01,0xE0,0x1E,0x03,0xB0,0x71,0x1F,0xFE,0x0F,0x01,0xF8,0x3F,0xC7,0x0E,0xE0,0x7C,0x03,0x80,0x18,0x01,0x80,0x18,0x01,
+	0xC0,0x3E,0x07,0x70,0xE3,0xFC,0x1F,0x80,0xF0,0x06,0x04,0x62,0x26,0x41,0xF8,0x1F,0x8F,0xFF,0xFF,0xF1,0xF8,0x1F,0x82,0x64,
+	0x46,0x20,0x60,0x18,0x18,0x18,0xFF,0xFF,0x18,0x18,0x18,0x1F,0xFE,0xFF,0xFF,0xF0,0xFF,0x80,0x00,0x20,0x0C,0x03,0x80,0xE0,
+	0x38,0x0E,0x03,0x80,0xE0,0x38,0x0E,0x03,0x80,0x00,0x7F,0xEF,0xFF,0xFF,0xF8,0x1D,0x87,0x99,0xE1,0xB8,0x1F,0xFF,0xFF,0xF7,
+	0xFE,0x18,0x11,0x81,0x18,0x13,0xFF,0xFF,0xFF,0xFF,0x00,0x10,0x01,0x00,0x10,0x60,0x3E,0x07,0xE0,0xF8,0x1D,0x83,0x98,0x71,
+	0xCE,0x1F,0xC7,0x78,0x73,0x07,0x60,0x6E,0x07,0xE0,0x78,0x61,0x86,0x18,0x61,0xCF,0x3F,0x9F,0x79,0xE3,0x0C,0x07,0x00,0xF0,
+	0x1B,0x03,0x31,0x63,0x1F,0xFF,0xFF,0xFF,0xFF,0x03,0x10,0x31,0xFE,0x6F,0xE7,0xFE,0x78,0x61,0x86,0x18,0x61,0x87,0x38,0x7F,
+	0x83,0xE8,0x1C,0x1F,0xE3,0xFF,0x7F,0xFE,0x61,0xC6,0x18,0x61,0x86,0x18,0x7F,0x07,0xF0,0x3E,0xF0,0x0F,0x00,0xF0,0x08,0x07,
+	0x80,0xF8,0x1F,0x83,0x88,0x70,0xFE,0x0F,0xC0,0xF8,0x00,0x79,0xEF,0x9F,0xFF,0xF8,0xE1,0x8E,0x18,0x71,0x87,0x1F,0xFF,0xF9,
+	0xF7,0x9E,0x7C,0x0F,0xE0,0xFE,0x18,0x61,0x86,0x18,0x63,0x86,0x7F,0xFE,0xFF,0xC7,0xF8,0xE7,0xE7,0xE7,0x00,0xF3,0xF9,0xFC,
+	0xE0,0x03,0x00,0x1E,0x00,0xFC,0x07,0x38,0x38,0x71,0xC0,0xEE,0x01,0xF0,0x03,0x80,0x04,0xCF,0x3C,0xF3,0xCF,0x3C,0xF3,0xCF,
+	0x3C,0xF3,0x80,0x07,0x00,0x3E,0x01,0xDC,0x0E,0x38,0x70,0x73,0x80,0xFC,0x01,0xE0,0x03,0x00,0x30,0x01,0xC0,0x06,0x00,0x38,
+	0x00,0xC1,0x9F,0x0E,0x7E,0x79,0xDF,0x80,0x7C,0x00,0xE0,0x00,0x7F,0xFB,0xFF,0xEF,0xFF,0xE0,0x03,0x80,0x0E,0x1E,0x38,0x78,
+	0xE1,0xE3,0xFF,0x8F,0xFE,0x17,0xF8,0x00,0x1F,0xF3,0xFF,0x7F,0xFE,0x10,0xC1,0x0C,0x10,0xE1,0x07,0xFF,0x3F,0xF1,0xFF,0x80,
+	0x1F,0xFF,0xFF,0xFF,0xFF,0x86,0x18,0x61,0x86,0x1F,0xFF,0xFF,0xF7,0x9E,0x3F,0xC7,0xFE,0xFF,0xFC,0x03,0x80,0x18,0x01,0x80,
+	0x1E,0x07,0xE0,0x76,0x06,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x80,0x18,0x01,0xC0,0x3F,0xFF,0x7F,0xE3,0xFC,0x80,0x1F,0xFF,0xFF,
+	0xFF,0xFF,0x86,0x18,0x61,0x86,0x18,0xF1,0xCF,0x3E,0x07,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x86,0x18,0x60,0x86,0x08,0xF0,0xCF,
+	0x0E,0x00,0x3F,0xC7,0xFE,0xFF,0xFC,0x03,0x80,0x18,0x11,0x81,0x1F,0x1F,0xF1,0xF7,0x1F,0xFF,0xFF,0xFF,0xFF,0xF0,0x60,0x06,
+	0x00,0x60,0xFF,0xFF,0xFF,0xFF,0xF0,0x80,0x18,0x01,0xFF,0xFF,0xFF,0xFF,0xF8,0x01,0x80,0x10,0x01,0xE0,0x1E,0x01,0xF0,0x01,
+	0x00,0x18,0x01,0x80,0x1F,0xFF,0xFF,0xFF,0xFE,0x80,0x08,0x00,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x0F,0x01,0xF8,0x39,0xCF,0x0F,
+	0xE0,0x7C,0x03,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x80,0x10,0x01,0x00,0x10,0x03,0x00,0x70,0x0F,0xFF,0xFF,0xFF,0xFF,0xF7,0x80,
+	0x3C,0x01,0xE0,0x3C,0x07,0x80,0xFF,0xFF,0xFF,0xFF,0xF0,0xFF,0xFF,0xFF,0xFF,0xF3,0x80,0x1C,0x00,0xE0,0x07,0x00,0x38,0xFF,
+	0xFF,0xFF,0xFF,0xF0,0x1F,0x83,0xFC,0x7F,0xEE,0x07,0xC0,0x3C,0x03,0xC0,0x3E,0x07,0x7F,0xE3,0xFC,0x1F,0x80,0x80,0x1F,0xFF,
+	0xFF,0xFF,0xFF,0x86,0x18,0x60,0x86,0x0F,0xE0,0xFE,0x07,0x80,0x1F,0x83,0xFF,0x1F,0xF9,0xC0,0xCC,0x06,0x40,0x77,0x07,0xBC,
+	0x3F,0x7F,0xFB,0xFF,0xC7,0xE2,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x86,0x08,0x60,0x87,0x0F,0xFF,0xFF,0xF7,0x8F,0x78,0xEF,0xCF,
+	0xFE,0xF8,0x61,0x86,0x18,0x61,0x86,0x1F,0x7F,0xF3,0xF7,0x1E,0xE0,0x0C,0x00,0x80,0x18,0x01,0xFF,0xFF,0xFF,0xFF,0xF8,0x01,
+	0x80,0x1C,0x00,0xE0,0x00,0xFF,0xEF,0xFF,0xFF,0xF0,0x01,0x00,0x10,0x01,0xFF,0xFF,0xFF,0xFF,0xE0,0xFF,0x8F,0xFC,0xFF,0xE0,
+	0x07,0x00,0x30,0x07,0xFF,0xEF,0xFC,0xFF,0x80,0xFF,0x0F,0xFC,0xFF,0xF0,0x0F,0x00,0xF0,0x7C,0x00,0xF0,0x0F,0xFF,0xFF,0xFC,
+	0xFF,0x00,0xE0,0x7F,0x0F,0xF9,0xF1,0xF8,0x0F,0x01,0xF8,0xF9,0xFF,0x0F,0xE0,0x70,0xF8,0x0F,0xC1,0xFE,0x10,0x7F,0x03,0xF0,
+	0x7F,0xFE,0x1F,0xC1,0xF8,0x00,0xF0,0x7E,0x0F,0xC1,0xF8,0x39,0x87,0x18,0xE1,0x9C,0x1F,0x83,0xF0,0x7E,0x0F,0xFF,0xFF,0xFF,
+	0xFF,0xF8,0x01,0x80,0x18,0x01,0x80,0x10,0xE0,0x07,0x00,0x38,0x01,0xC0,0x0E,0x00,0x70,0x03,0x80,0x1C,0x00,0xE0,0x06,0x00,
+	0x30,0x80,0x18,0x01,0x80,0x18,0x01,0xFF,0xFF,0xFF,0xFF,0xF0,0x08,0xCE,0xEE,0x71,0xC7,0x18,0x40,0xFF,0xFF,0xFF,0xCC,0xF3,
+	0x30,0x0E,0x9F,0x9F,0x91,0x91,0x91,0xFF,0xFE,0x7F,0x01,0x80,0x1F,0xFF,0xFF,0xEF,0xFF,0x08,0x10,0x81,0x08,0x10,0xFF,0x0F,
+	0xF0,0x7E,0x7E,0xFF,0xFF,0x81,0x81,0x81,0xE7,0xE7,0x66,0x07,0xE0,0xFF,0x0F,0xF0,0x81,0x08,0x18,0x81,0xFF,0xFF,0xFE,0xFF,
+	0xF8,0x01,0x7E,0xFF,0xFF,0x91,0x91,0x91,0xF7,0xF7,0x76,0x06,0x10,0x61,0x7F,0xFF,0xFF,0xFF,0xF8,0x61,0xE6,0x1E,0x60,0x60,
+	0x00,0x78,0xBF,0x3F,0xEE,0x19,0x86,0x61,0x9F,0xFD,0xFF,0xFF,0xA0,0x00,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x06,0x00,0x80,0x08,
+	0x00,0xFF,0x0F,0xF0,0x7F,0x08,0x10,0x81,0x08,0x1E,0xFF,0xEF,0xFE,0xFF,0x00,0x10,0x01,0x00,0x10,0x00,0x10,0x00,0x60,0x01,
+	0xC2,0x01,0x08,0x04,0x20,0x3E,0xFF,0xFB,0xFF,0xEF,0xF8,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x01,0x00,0x38,0x07,0xC0,0xEF,0x0C,
+	0x70,0x83,0x80,0x18,0x01,0x80,0x1F,0xFF,0xFF,0xFF,0xFF,0x00,0x10,0x01,0x00,0x10,0xFF,0xFF,0xFF,0x80,0x80,0xFF,0x80,0x80,
+	0xFF,0xFF,0x7F,0xFF,0xFF,0xFF,0x80,0x80,0x80,0xFF,0xFF,0x7F,0x7E,0xFF,0xFF,0x81,0x81,0x81,0xFF,0xFF,0x7E,0x80,0x7F,0xF7,
+	0xFF,0xFF,0x82,0x60,0x88,0x23,0xF8,0xFE,0x1F,0x00,0x7C,0x3F,0x8F,0xE2,0x08,0x82,0x20,0x9F,0xFD,0xFF,0xFF,0xE0,0x10,0x81,
+	0xFF,0xFF,0xFF,0x61,0xC0,0xC0,0xE0,0xE0,0x60,0x66,0xF7,0xF1,0x99,0x99,0x99,0x8F,0xEF,0x66,0x10,0x02,0x00,0xFF,0x3F,0xFF,
+	0xFE,0x20,0x44,0x38,0x87,0x10,0xC0,0xFE,0xFF,0xFF,0x01,0x01,0x01,0xFF,0xFE,0xFF,0x01,0xF8,0xFC,0xFE,0x07,0x03,0x07,0xFE,
+	0xFC,0xF8,0xF8,0xFC,0xFF,0x07,0x07,0x1C,0x07,0x07,0xFF,0xFC,0xF8,0xC3,0xE7,0xFF,0x3C,0x3C,0xFF,0xE7,0xC3,0x00,0x7E,0x1F,
+	0xC7,0xF9,0x06,0xC1,0xF0,0x7B,0xFC,0xFC,0x3E,0x00,0xE3,0xC7,0x8F,0x9D,0xB9,0xF1,0xE3,0xC7,0x06,0x00,0x60,0x0F,0x07,0x9E,
+	0xF9,0xFF,0x0F,0x80,0x18,0x01,0x80,0x18,0x01,0xFF,0xFF,0xFF,0xFF,0xFF,0xC0,0x80,0x18,0x01,0x80,0x18,0x01,0xF0,0xFF,0x9F,
+	0x79,0xE0,0xF0,0x06,0x00,0x60,0x77,0xE3,0x1F,0xB8
+};
@@ -0,0 +1,62 @@
+// Sprites.h
+// Palette-indexed, run-length encoded sprites for TFT_Sprite()
+// GENERATED by tools/spritegen.py from tools/icons/*.png - edit the images, not this file
+// Layout: width, height, bpp, palette entries, run count (2 bytes), RGB565 palette, runs
+
+// battery.png: 79x157, 3 colours, 458 runs
+const unsigned char SPRITE_BATTERY[470] PROGMEM = {
+	0x4F,0x9D,0x02,0x03,0xCA,0x01,0x86,0x31,0xEF,0x7B,0x8A,0x52,0x09,0x7F,0x7F,0x52,0x09,0x7F,0x7F,0x52,0x09,0x41,0xBF,0xBF,
+	0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,
+	0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,
+	0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,
+	0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,
+	0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x4D,0xBF,0xBF,0x8E,0x4D,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,0xBF,0xBF,0x8E,0x43,0x87,0x41,
+	0xBF,0xBF,0x8E,0x4D,0xBF,0xBF,0x8E,0x4D,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,
+	0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,
+	0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,
+	0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,
+	0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x41,0xBF,0xBF,0x8E,0x41,
+	0x09,0x41,0xBF,0xBF,0x8E,0x41,0x09,0x7F,0x7F,0x52,0x09,0x7F,0x7F,0x52
+};
+
+// bms.png: 16x16, 3 colours, 125 runs
+const unsigned char SPRITE_BMS[137] PROGMEM = {
+	0x10,0x10,0x02,0x03,0x7D,0x00,0xEF,0x7B,0xFF,0xFF,0xE0,0x07,0x21,0x4C,0x01,0x41,0x0A,0x40,0x01,0x41,0x00,0x80,0x00,0x80,
+	0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x02,0x40,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x02,0x40,
+	0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x02,0x40,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,
+	0x00,0x40,0x02,0x40,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x02,0x40,0x00,0x80,0x00,0x80,0x00,0x80,
+	0x00,0x80,0x00,0x80,0x00,0x40,0x02,0x40,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x01,0x41,0x00,0x80,
+	0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x40,0x01,0x41,0x0A,0x40,0x02,0x4C,0x20
+};
+
+// charger.png: 16x16, 3 colours, 29 runs
+const unsigned char SPRITE_CHARGER[41] PROGMEM = {
+	0x10,0x10,0x02,0x03,0x1D,0x00,0xEF,0x7B,0xFF,0xFF,0xE0,0x07,0x33,0x43,0x0B,0x45,0x06,0x49,0x05,0x4A,0x07,0x41,0x80,0x47,
+	0x04,0x42,0x83,0x43,0x01,0x44,0x81,0x40,0x80,0x41,0x04,0x49,0x08,0x45,0x09,0x43,0x37
+};
+
+// motor.png: 16x16, 3 colours, 77 runs
+const unsigned char SPRITE_MOTOR[89] PROGMEM = {
+	0x10,0x10,0x02,0x03,0x4D,0x00,0xEF,0x7B,0xFF,0xFF,0xE0,0x07,0x06,0x41,0x0B,0x45,0x07,0x41,0x01,0x41,0x01,0x41,0x04,0x40,
+	0x09,0x40,0x03,0x40,0x00,0x46,0x01,0x40,0x02,0x40,0x01,0x86,0x02,0x40,0x01,0x40,0x02,0x80,0x07,0x40,0x01,0x40,0x03,0x80,
+	0x06,0x40,0x01,0x40,0x03,0x80,0x06,0x40,0x01,0x40,0x02,0x80,0x07,0x40,0x01,0x40,0x01,0x86,0x02,0x40,0x02,0x40,0x00,0x46,
+	0x01,0x40,0x03,0x40,0x09,0x40,0x04,0x41,0x01,0x41,0x01,0x41,0x07,0x45,0x0B,0x41,0x06
+};
+
+// warning.png: 32x28, 4 colours, 122 runs
+const unsigned char SPRITE_WARNING[136] PROGMEM = {
+	0x20,0x1C,0x02,0x04,0x7A,0x00,0x00,0x00,0x00,0xF8,0xE0,0xFF,0x00,0x00,0x1A,0x40,0x18,0x42,0x16,0x44,0x14,0x46,0x13,0x44,
+	0x80,0x41,0x11,0x44,0x82,0x41,0x0F,0x45,0x83,0x41,0x0D,0x45,0x85,0x41,0x0C,0x44,0x87,0x41,0x0A,0x44,0x89,0x41,0x08,0x45,
+	0x8A,0x41,0x06,0x45,0x8C,0x41,0x05,0x44,0x8E,0x41,0x03,0x44,0x90,0x41,0x01,0x45,0xCA,0x81,0xC2,0x81,0x47,0x81,0xCA,0x81,
+	0xC2,0x81,0x47,0x81,0xCA,0x81,0xC2,0x81,0x41,0x01,0x45,0xCA,0x81,0xC2,0x81,0x41,0x03,0x44,0x90,0x41,0x05,0x44,0x8E,0x41,
+	0x06,0x45,0x8C,0x41,0x08,0x45,0x8A,0x41,0x0A,0x44,0x89,0x41,0x0C,0x44,0x87,0x41,0x0D,0x45,0x85,0x41,0x0F,0x45,0x83,0x41,
+	0x11,0x44,0x82,0x41,0x13,0x44,0x80,0x41,0x14,0x46,0x16,0x44,0x18,0x42,0x1A,0x40
+};
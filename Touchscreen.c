@@ -11,6 +11,8 @@
 #include <string.h>
 
 #include "Fonts.h"
+#include "PropFont.h"
+#include "BigFont.h"
 
 // Private utility function
 static inline unsigned char ReverseByte(unsigned char x);
@@ -18,6 +20,19 @@ static inline unsigned char ReverseByte(unsigned char x);
 static int type;
 static char swapX;
 
+// ILI9341 windows fill column by column, because TFT_SetBounds puts screen X on the panel's page axis.
+// With ROTATE180 (and on the old panel) those columns run right to left, top to bottom; the plain
+// NEW_LCD orientation is the exact reverse of that, left to right, bottom to top.
+#if defined ROTATE180 || !defined NEW_LCD
+	#define WINDOW_REVERSED	0
+#else
+	#define WINDOW_REVERSED	1
+#endif
+
+// Burst pixel path: once a window is open, a run of same coloured pixels only needs WR strobes
+static char burstPrimed;
+static unsigned int burstColour;
+
 #define TOUCH_SCALING	1 // 7/6 was used on one of the screens to correct scaling
 
 void TFT_Init(int displayType, char swapXtouch)
@@ -369,6 +384,48 @@ void TFT_Box(unsigned int x1,unsigned int y1,unsigned int x2,unsigned int y2,uns
     CS_PORT |= CS;	// TFT_CS  = 1;
 }
 
+// Outline of a box as four non-overlapping strips, so no pixel is written twice
+void TFT_Frame(unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2, unsigned char thickness, unsigned int color)
+{
+	TFT_Box(x1, y1, x2, y1+thickness-1, color); // top
+	TFT_Box(x1, y2-thickness+1, x2, y2, color); // bottom
+	TFT_Box(x1, y1+thickness, x1+thickness-1, y2-thickness, color); // left
+	TFT_Box(x2-thickness+1, y1+thickness, x2, y2-thickness, color); // right
+}
+
+static inline void TFT_BeginBurst()
+{
+	RS_PORT |= RS;
+	CS_PORT &= ~CS;
+	burstPrimed = 0;
+}
+
+static inline void TFT_BurstPixels(unsigned int color, unsigned char count)
+{
+	if (!burstPrimed || color != burstColour)
+	{
+#ifdef NEW_LCD
+		DP_Hi = ReverseByte(color>>8);
+#else
+		DP_Hi = (color>>8);
+#endif
+		DP_Lo = color;
+		burstColour = color;
+		burstPrimed = 1;
+	}
+
+	while (count--)
+	{
+		WR_PORT &= ~WR;
+		WR_PORT |= WR;
+	}
+}
+
+static inline void TFT_EndBurst()
+{
+	CS_PORT |= CS;
+}
+
 void TFT_H_Line(unsigned int x1, unsigned int x2, unsigned int y_pos,unsigned int color)
 {
     TFT_Box(x1,y_pos,x2,y_pos,color);
@@ -464,6 +521,329 @@ void TFT_CentredText(char* S, unsigned int x, unsigned int y, char scale, unsign
 	TFT_Text(S, x - pixelsWide/2, y, scale, Fcolor, Bcolor);
 }
 
+// _P versions take strings stored in flash (PSTR or PROGMEM), so they don't need a copy in SRAM
+void TFT_Text_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	char c;
+	while ((c = pgm_read_byte(S++)))
+	{
+		TFT_Char(c, x, y, scale, Fcolor, Bcolor);
+		x = x + 12*scale;
+	}
+}
+
+void TFT_CentredText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	int pixelsWide = strlen_P(S) * 12 * scale;
+	TFT_Text_P(S, x - pixelsWide/2, y, scale, Fcolor, Bcolor);
+}
+
+// Proportional text, using the cropped glyphs in PropFont.h (see tools/fontgen.py)
+static inline unsigned char PropAdvance(char c)
+{
+	if (c < PROP_FONT_FIRST || c >= PROP_FONT_FIRST+PROP_FONT_COUNT) c = '?';
+	return pgm_read_byte(&PROP_FONT_METRICS[c-PROP_FONT_FIRST][4]);
+}
+
+static inline unsigned char PropBit(const unsigned char* bits, unsigned short n)
+{
+	return pgm_read_byte(&bits[n>>3]) & (0x80>>(n&0x07));
+}
+
+// Draws one glyph cell (advance x 16 pixels, background included) and returns its advance
+static unsigned char TFT_PropChar(char c, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor)
+{
+	if (c < PROP_FONT_FIRST || c >= PROP_FONT_FIRST+PROP_FONT_COUNT) c = '?';
+	const unsigned char* metrics = PROP_FONT_METRICS[c-PROP_FONT_FIRST];
+
+	const unsigned char* bits = PROP_FONT_BITS + pgm_read_byte(&metrics[0]) + (pgm_read_byte(&metrics[1])<<8);
+	unsigned char top = pgm_read_byte(&metrics[2])>>4;
+	unsigned char rows = (pgm_read_byte(&metrics[2])&0x0F) + 1;
+	unsigned char cols = pgm_read_byte(&metrics[3])>>4;
+	unsigned char left = pgm_read_byte(&metrics[3])&0x0F;
+	unsigned char advance = pgm_read_byte(&metrics[4]);
+
+	if (x > 320 - advance || y > 240 - PROP_FONT_HEIGHT) return advance; // Off screen
+	if (cols == 0) rows = 0; // Blank glyph, e.g space
+
+	if (type == ILI9341) // Whole cell in one window, streamed in the controller's fill order
+	{
+		TFT_SetBounds(x, y, x+advance-1, y+PROP_FONT_HEIGHT-1);
+		TFT_BeginBurst();
+		for (unsigned char i=0; i<advance; i++)
+		{
+#if WINDOW_REVERSED
+			unsigned char col = i - left; // Left to right
+#else
+			unsigned char col = advance-1-i - left; // Right to left
+#endif
+			if (col >= cols) // Also catches columns left of the ink, which wrap round to large numbers
+			{
+				TFT_BurstPixels(Bcolor, PROP_FONT_HEIGHT);
+				continue;
+			}
+
+			unsigned short n = (unsigned short)col*rows;
+#if WINDOW_REVERSED
+			TFT_BurstPixels(Bcolor, PROP_FONT_HEIGHT-top-rows);
+			n += rows;
+			for (unsigned char r=0; r<rows; r++) TFT_BurstPixels(PropBit(bits, --n) ? Fcolor : Bcolor, 1);
+			TFT_BurstPixels(Bcolor, top);
+#else
+			TFT_BurstPixels(Bcolor, top);
+			for (unsigned char r=0; r<rows; r++) TFT_BurstPixels(PropBit(bits, n++) ? Fcolor : Bcolor, 1);
+			TFT_BurstPixels(Bcolor, PROP_FONT_HEIGHT-top-rows);
+#endif
+		}
+		TFT_EndBurst();
+	}
+	else // Older controllers: a thin window per row, the same as TFT_Char
+	{
+		for (unsigned char r=0; r<PROP_FONT_HEIGHT; r++)
+		{
+			TFT_SetBounds(x, y+r, x+advance-1, y+r);
+			TFT_BeginBurst();
+			for (unsigned char i=0; i<advance; i++)
+			{
+#if WINDOW_REVERSED
+				unsigned char col = i - left;
+#else
+				unsigned char col = advance-1-i - left;
+#endif
+				unsigned char row = r - top;
+				if (col < cols && row < rows && PropBit(bits, (unsigned short)col*rows + row))
+					TFT_BurstPixels(Fcolor, 1);
+				else
+					TFT_BurstPixels(Bcolor, 1);
+			}
+			TFT_EndBurst();
+		}
+	}
+
+	return advance;
+}
+
+unsigned int TFT_PropTextWidth(char* S)
+{
+	unsigned int width = 0;
+	while (*S) width += PropAdvance(*S++);
+	return width;
+}
+
+void TFT_PropText(char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor)
+{
+	while (*S) x += TFT_PropChar(*S++, x, y, Fcolor, Bcolor);
+}
+
+void TFT_CentredPropText(char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor)
+{
+	TFT_PropText(S, x - TFT_PropTextWidth(S)/2, y, Fcolor, Bcolor);
+}
+
+unsigned int TFT_PropTextWidth_P(const char* S)
+{
+	unsigned int width = 0;
+	char c;
+	while ((c = pgm_read_byte(S++))) width += PropAdvance(c);
+	return width;
+}
+
+void TFT_PropText_P(const char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor)
+{
+	char c;
+	while ((c = pgm_read_byte(S++))) x += TFT_PropChar(c, x, y, Fcolor, Bcolor);
+}
+
+void TFT_CentredPropText_P(const char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor)
+{
+	TFT_PropText_P(S, x - TFT_PropTextWidth_P(S)/2, y, Fcolor, Bcolor);
+}
+
+
+// Run-length encoded images: the big fonts in BigFont.h and the sprites in Sprites.h (see tools/bigfontgen.py
+// and tools/spritegen.py). Each run byte is a palette index in the top bpp bits and length-1 in the rest.
+// Runs are stored in the ROTATE180 fill order, so a whole image streams into one window, and the other
+// orientation just walks them backwards. Other panels get one TFT_Box per run within a column.
+static void TFT_RLEBlit(const unsigned char* runs, unsigned short length, unsigned int x, unsigned int y, unsigned char width, unsigned char height, unsigned char bpp, const unsigned int* palette)
+{
+	unsigned char shift = 8 - bpp;
+	unsigned char mask = 0xFF >> bpp;
+
+	if (type == ILI9341)
+	{
+		TFT_SetBounds(x, y, x+width-1, y+height-1);
+		TFT_BeginBurst();
+		for (unsigned short i=0; i<length; i++)
+		{
+#if WINDOW_REVERSED
+			unsigned char run = pgm_read_byte(&runs[length-1-i]);
+#else
+			unsigned char run = pgm_read_byte(&runs[i]);
+#endif
+			TFT_BurstPixels(palette[run >> shift], (run & mask) + 1);
+		}
+		TFT_EndBurst();
+	}
+	else
+	{
+		unsigned char col = width-1, row = 0;
+		for (unsigned short i=0; i<length; i++)
+		{
+			unsigned char run = pgm_read_byte(&runs[i]);
+			unsigned char n = (run & mask) + 1;
+			while (n > 0)
+			{
+				unsigned char segment = (n < height-row) ? n : height-row;
+				TFT_Box(x+col, y+row, x+col, y+row+segment-1, palette[run >> shift]);
+				n -= segment;
+				row += segment;
+				if (row == height)
+				{
+					row = 0;
+					col--;
+				}
+			}
+		}
+	}
+}
+
+// One character from the pre-rendered fonts, or pixel doubled by TFT_Char if it isn't in them (or for scale 1)
+static void TFT_LargeChar(char c, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	const char* chars = BIG_FONT_CHARS;
+	const unsigned short* index = BIG_FONT_INDEX;
+	const unsigned char* runs = BIG_FONT_RUNS;
+	if (scale == 3)
+	{
+		chars = TITLE_FONT_CHARS;
+		index = TITLE_FONT_INDEX;
+		runs = TITLE_FONT_RUNS;
+	}
+
+	const char* found = (type == ILI9341 && (scale == 2 || scale == 3)) ? strchr_P(chars, c) : 0;
+	if (found == 0 || x > 320 - 12*scale || y > 240 - 16*scale) // Not pre-rendered (or older panel), so pixel double it
+	{
+		TFT_Char(c, x, y, scale, Fcolor, Bcolor);
+		return;
+	}
+
+	unsigned int palette[2] = { Bcolor, Fcolor };
+	unsigned char n = found - chars;
+	unsigned short start = pgm_read_word(&index[n]);
+	TFT_RLEBlit(runs + start, pgm_read_word(&index[n+1]) - start, x, y, 12*scale, 16*scale, 1, palette);
+}
+
+void TFT_LargeText(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	for (; *S; S++, x += 12*scale) TFT_LargeChar(*S, x, y, scale, Fcolor, Bcolor);
+}
+
+void TFT_CentredLargeText(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	int pixelsWide = strlen(S) * 12 * scale;
+	TFT_LargeText(S, x - pixelsWide/2, y, scale, Fcolor, Bcolor);
+}
+
+void TFT_LargeText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	char c;
+	for (; (c = pgm_read_byte(S)); S++, x += 12*scale) TFT_LargeChar(c, x, y, scale, Fcolor, Bcolor);
+}
+
+void TFT_CentredLargeText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	int pixelsWide = strlen_P(S) * 12 * scale;
+	TFT_LargeText_P(S, x - pixelsWide/2, y, scale, Fcolor, Bcolor);
+}
+
+
+// Fixed point number formatter, drawing each character straight to the screen with no string in between.
+// Rounds off the bottom dropDigits digits of value, then shows decimals of the rest after a decimal point
+// e.g value = 12345 (mV), dropDigits = 1, decimals = 2 gives "12.35". The unit (a flash string) follows it, and the
+// whole field is padded with spaces out to width characters (left, right or centre aligned) to blank old values.
+// Returns the x position just after the field, for drawing whatever follows it.
+// Digits come from subtracting powers of ten, as the AVR has no divide instruction.
+static const unsigned long POWERS_OF_TEN[10] PROGMEM = { 1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+
+unsigned int TFT_Number(long value, unsigned char dropDigits, unsigned char decimals, unsigned char width, char align, const char* unit, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor)
+{
+	unsigned long magnitude = (value < 0) ? -value : value;
+	if (dropDigits > 0) magnitude += pgm_read_dword(&POWERS_OF_TEN[10-dropDigits]) * 5; // Round half up
+
+	char last = 9 - dropDigits; // Index of the last digit shown, and of the units digit
+	char units = last - decimals;
+	char first = 0;
+	while (first < units && magnitude < pgm_read_dword(&POWERS_OF_TEN[first])) first++;
+
+	char negative = (value < 0 && magnitude >= pgm_read_dword(&POWERS_OF_TEN[last])); // No "-0.0"
+	char length = negative + last - first + 1 + (decimals > 0);
+	length += strlen_P(unit);
+	char padding = (width > length) ? width - length : 0;
+
+	char step = 12*scale;
+	char leading = 0;
+	if (align == ALIGN_RIGHT) leading = padding;
+	if (align == ALIGN_CENTRE) leading = padding/2;
+	padding -= leading;
+	for (; leading > 0; leading--, x += step) TFT_LargeChar(' ', x, y, scale, Fcolor, Bcolor);
+
+	if (negative)
+	{
+		TFT_LargeChar('-', x, y, scale, Fcolor, Bcolor);
+		x += step;
+	}
+
+	for (char i=first; i<=last; i++)
+	{
+		unsigned long power = pgm_read_dword(&POWERS_OF_TEN[i]);
+		char digit = '0';
+		while (magnitude >= power)
+		{
+			magnitude -= power;
+			digit++;
+		}
+		TFT_LargeChar(digit, x, y, scale, Fcolor, Bcolor);
+		x += step;
+
+		if (i == units && decimals > 0)
+		{
+			TFT_LargeChar('.', x, y, scale, Fcolor, Bcolor);
+			x += step;
+		}
+	}
+
+	char c;
+	for (; (c = pgm_read_byte(unit)); unit++, x += step) TFT_LargeChar(c, x, y, scale, Fcolor, Bcolor);
+	for (; padding > 0; padding--, x += step) TFT_LargeChar(' ', x, y, scale, Fcolor, Bcolor);
+	return x;
+}
+
+unsigned char TFT_SpritePalette(const unsigned char* sprite, unsigned int* palette)
+{
+	unsigned char count = pgm_read_byte(&sprite[SPRITE_COLOURS]);
+	for (unsigned char i=0; i<count; i++)
+		palette[i] = pgm_read_word(&sprite[SPRITE_HEADER_SIZE+i*2]);
+	return count;
+}
+
+void TFT_Sprite(const unsigned char* sprite, unsigned int x, unsigned int y, const unsigned int* palette)
+{
+	unsigned char width = pgm_read_byte(&sprite[SPRITE_WIDTH]);
+	unsigned char height = pgm_read_byte(&sprite[SPRITE_HEIGHT]);
+	if (x > 320 - width || y > 240 - height) return; // Ignore if the sprite is off screen
+
+	unsigned int defaultPalette[16];
+	if (palette == 0)
+	{
+		TFT_SpritePalette(sprite, defaultPalette);
+		palette = defaultPalette;
+	}
+
+	unsigned short length = pgm_read_word(&sprite[SPRITE_RUN_COUNT]);
+	const unsigned char* runs = sprite + SPRITE_HEADER_SIZE + pgm_read_byte(&sprite[SPRITE_COLOURS])*2;
+	TFT_RLEBlit(runs, length, x, y, width, height, pgm_read_byte(&sprite[SPRITE_BPP]), palette);
+}
+
 
 // Touch screen stuff
 void Touch_Init()
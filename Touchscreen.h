@@ -93,6 +93,19 @@ enum { SSD1289, ILI9325, ILI9341 };
 unsigned short TP_X, TP_Y; // Variables holding raw touch data
 
 
+// Alignment of TFT_Number fields
+#define ALIGN_LEFT	0
+#define ALIGN_RIGHT	1
+#define ALIGN_CENTRE	2
+
+// Sprite header layout (see tools/spritegen.py), followed by the RGB565 palette and then the runs
+#define SPRITE_WIDTH		0
+#define SPRITE_HEIGHT		1
+#define SPRITE_BPP			2
+#define SPRITE_COLOURS		3
+#define SPRITE_RUN_COUNT	4
+#define SPRITE_HEADER_SIZE	6
+
 // TFT functions
 void TFT_Init(int displayType, char swapXtouch);
 void TFT_WriteCommand(unsigned int command);
@@ -106,6 +119,22 @@ void TFT_H_Line(unsigned int x1, unsigned int x2,unsigned int y_pos,unsigned int
 void TFT_Char(char C,unsigned int x,unsigned int y,char DimFont,unsigned int Fcolor,unsigned int Bcolor);
 void TFT_Text(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
 void TFT_CentredText(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_Text_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_CentredText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_PropText(char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_CentredPropText(char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor);
+unsigned int TFT_PropTextWidth(char* S);
+void TFT_PropText_P(const char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_CentredPropText_P(const char* S, unsigned int x, unsigned int y, unsigned int Fcolor, unsigned int Bcolor);
+unsigned int TFT_PropTextWidth_P(const char* S);
+void TFT_LargeText(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_CentredLargeText(char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_LargeText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+void TFT_CentredLargeText_P(const char* S, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+unsigned int TFT_Number(long value, unsigned char dropDigits, unsigned char decimals, unsigned char width, char align, const char* unit, unsigned int x, unsigned int y, char scale, unsigned int Fcolor, unsigned int Bcolor);
+unsigned char TFT_SpritePalette(const unsigned char* sprite, unsigned int* palette);
+void TFT_Sprite(const unsigned char* sprite, unsigned int x, unsigned int y, const unsigned int* palette);
+void TFT_Frame(unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2, unsigned char thickness, unsigned int color);
 
 // Touch functions
 void Touch_Init();
@@ -22,9 +22,27 @@
 //_____ I N C L U D E S ________________________________________________________
 #include "config.h"
 #include "can_drv.h"
+#include <avr/pgmspace.h>
 
 //_____ D E F I N I T I O N S __________________________________________________
 
+#if FOSC == 16000
+//! Bit timing for each can_bitrate_t, same values as CONF_CANBTx in "can_drv.h"
+static const U8 can_bt_table[CAN_NUM_BITRATES][3] PROGMEM = {
+    { 0x0E, 0x0C, 0x37 },   // 125Kb/s, 16x Tscl, sampling at 75%
+    { 0x06, 0x0C, 0x37 },   // 250Kb/s, 16x Tscl, sampling at 75%
+    { 0x06, 0x04, 0x13 },   // 500Kb/s,  8x Tscl, sampling at 75%
+    { 0x02, 0x04, 0x13 } }; //   1Mb/s,  8x Tscl, sampling at 75%
+#else
+#   error Run-time bit rates are only defined for FOSC = 16 MHz in "can_drv.c"
+#endif
+
+//! CAN timer prescaler while detecting: Fclkio/8/(1+1) overflows every 65.5 ms
+#define DETECT_CANTCON  1
+
+//! Bit timing programmed by "can_fixed_baudrate()"
+static U8 can_bt[3] = { CONF_CANBT1, CONF_CANBT2, CONF_CANBT3 };
+
 //_____ F U N C T I O N S ______________________________________________________
 
 //------------------------------------------------------------------------------
@@ -406,10 +424,119 @@ U8 can_auto_baudrate (U8 mode)
 U8 can_fixed_baudrate(U8 mode)
 {
     Can_reset();
-    Can_conf_bt();
+    CANBT1 = can_bt[0];
+    CANBT2 = can_bt[1];
+    CANBT3 = can_bt[2];
     return 1;
 }
 
+//------------------------------------------------------------------------------
+//  @fn can_select_bitrate
+//!
+//! This function chooses the bit rate that "can_fixed_baudrate()" (and so
+//! "can_init()") will program next time.
+//!
+//! @warning The CAN controller is not touched, call "can_init()" after it.
+//!
+//! @param  can_bitrate_t index
+//!
+//! @return Bitrate Status
+//!         ==0: unknown bit rate, the previous one is kept
+//!         ==1: bit rate selected
+//------------------------------------------------------------------------------
+U8 can_select_bitrate(U8 index)
+{
+    if (index >= CAN_NUM_BITRATES) return 0;
+    can_bt[0] = pgm_read_byte(&can_bt_table[index][0]);
+    can_bt[1] = pgm_read_byte(&can_bt_table[index][1]);
+    can_bt[2] = pgm_read_byte(&can_bt_table[index][2]);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//  @fn can_listen_bitrate
+//!
+//! Listens at one bit rate until a message is received, a bus error is seen
+//! or the CAN timer overflows twice (65 to 130 ms).
+//!
+//! @param  can_bitrate_t index
+//!
+//! @return ==1: a message was received without error at this bit rate
+//------------------------------------------------------------------------------
+static U8 can_listen_bitrate(U8 index)
+{
+    U8 heard = 0;
+    U8 overflows = 0;
+
+    Can_reset();
+    CANBT1 = pgm_read_byte(&can_bt_table[index][0]);
+    CANBT2 = pgm_read_byte(&can_bt_table[index][1]);
+    CANBT3 = pgm_read_byte(&can_bt_table[index][2]);
+
+    Can_set_mob(MOB_0);
+    Can_clear_mob();
+    CANCDMOB = (MOB_Rx_ENA << CONMOB);  //! MOb 0 receives anything
+
+    CANGCON = (1<<LISTEN) | (1<<ENASTB);//! Enable CAN controller in "listen" mode
+    while ((CANGSTA & (1<<ENFG)) == 0); //! Wait for Enable OK
+    CANGIT = 0xFF;                      //! Reset General errors and OVRTIM flag
+
+    while (1)
+    {
+        if (CANSTMOB & (1<<RXOK)) { heard = 1; break; }
+        if ((CANSTMOB & ERR_MOB_MSK) || (CANGIT & ERR_GEN_MSK)) break; // Wrong bit rate
+        if (CANGIT & (1<<OVRTIM))
+        {
+            CANGIT = (1<<OVRTIM);       //! First overflow may come early, the timer wasn't reset
+            if (++overflows == 2) break;
+        }
+    }
+
+    DISABLE_MOB;
+    Can_clear_status_mob();
+    CANGCON = 0x00;                     //! Disable CAN controller & reset "listen" mode
+    while ((CANGSTA & (1<<ENFG)) != 0); //! Wait for Disable OK
+    return heard;
+}
+
+//------------------------------------------------------------------------------
+//  @fn can_detect_bitrate
+//!
+//! This function listens to the CAN bus in "listen" (silent) mode with up to
+//! "tries" bit rates in turn, starting with "first", until a message is
+//! received without error. The bit rate found is selected for "can_init()".
+//!
+//! @warning The CAN controller is left disabled, and all MObs are cleared.
+//!
+//! @param  can_bitrate_t index to try first
+//! @param  number of bit rates to try, CAN_NUM_BITRATES for all of them
+//!
+//! @return can_bitrate_t index of the bit rate found, or CAN_NO_BITRATE if
+//!         nothing was heard on any of them
+//------------------------------------------------------------------------------
+U8 can_detect_bitrate(U8 first, U8 tries)
+{
+    U8 index = (first < CAN_NUM_BITRATES) ? first : 0;
+    U8 found = CAN_NO_BITRATE;
+    U8 tcon = CANTCON;
+
+    CANTCON = DETECT_CANTCON;
+    for (; tries > 0; tries--)
+    {
+        if (can_listen_bitrate(index))
+        {
+            found = index;
+            can_select_bitrate(found);
+            break;
+        }
+        if (++index == CAN_NUM_BITRATES) index = 0;
+    }
+    CANTCON = tcon;
+
+    can_clear_all_mob();
+    return found;
+}
+
 
 
 
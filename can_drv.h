@@ -150,6 +150,14 @@
 #   define Can_bit_timing(mode)  (can_fixed_baudrate(mode))
 #endif
     // ----------
+    //! Bit rates that can be chosen at run time with "can_select_bitrate()" or
+    //! found on the bus with "can_detect_bitrate()". Index n runs at (125 << n) Kb/s
+typedef enum {
+        CAN_BITRATE_125, CAN_BITRATE_250, CAN_BITRATE_500, CAN_BITRATE_1000,
+        CAN_NUM_BITRATES                                                } can_bitrate_t;
+#define CAN_NO_BITRATE  0xFF
+#define Can_bitrate_kbps(index)  (125 << (index))
+    // ----------
 #define CAN_PORT_IN     PIND
 #define CAN_PORT_DIR    DDRD
 #define CAN_PORT_OUT    PORTD
@@ -408,8 +416,9 @@ extern  U8 can_auto_baudrate(U8 eval);
 //------------------------------------------------------------------------------
 //  @fn can_fixed_baudrate
 //!
-//! This function programs the CANBTx registers with the predefined values
-//! CONF_CANBT1, CONF_CANBT2, CONF_CANBT3.
+//! This function programs the CANBTx registers with the bit rate chosen by
+//! "can_select_bitrate()", or the predefined values CONF_CANBT1, CONF_CANBT2,
+//! CONF_CANBT3 if it hasn't been called.
 //!
 //! @warning
 //!
@@ -420,6 +429,41 @@ extern  U8 can_auto_baudrate(U8 eval);
 //!
 extern U8 can_fixed_baudrate(U8 eval);
 
+//------------------------------------------------------------------------------
+//  @fn can_select_bitrate
+//!
+//! This function chooses the bit rate that "can_fixed_baudrate()" (and so
+//! "can_init()") will program next time.
+//!
+//! @warning The CAN controller is not touched, call "can_init()" after it.
+//!
+//! @param  can_bitrate_t index
+//!
+//! @return Bitrate Status
+//!         ==0: unknown bit rate, the previous one is kept
+//!         ==1: bit rate selected
+//!
+extern U8 can_select_bitrate(U8 index);
+
+//------------------------------------------------------------------------------
+//  @fn can_detect_bitrate
+//!
+//! This function listens to the CAN bus in "listen" (silent) mode with up to
+//! "tries" bit rates in turn, starting with "first", until a message is
+//! received without error. A bit rate is given up on at the first bus error,
+//! or after 65 to 130 ms without a message, so the whole search takes well
+//! under a second. The bit rate found is selected for "can_init()".
+//!
+//! @warning The CAN controller is left disabled, and all MObs are cleared.
+//!
+//! @param  can_bitrate_t index to try first
+//! @param  number of bit rates to try, CAN_NUM_BITRATES for all of them
+//!
+//! @return can_bitrate_t index of the bit rate found, or CAN_NO_BITRATE if
+//!         nothing was heard on any of them
+//!
+extern U8 can_detect_bitrate(U8 first, U8 tries);
+
 //______________________________________________________________________________
 
 #endif // _CAN_DRV_H_
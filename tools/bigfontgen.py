@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# bigfontgen.py
+# Offline generator for the pre-rendered large numeral fonts used by TFT_LargeText().
+# Reads FONT_16x16 from Fonts.h, upscales the glyphs we need with Scale2x/Scale3x (so diagonals
+# come out smooth rather than as pixel-doubled stairs) and writes run-length encoded BigFont.h
+#
+# Usage: python3 tools/bigfontgen.py [Fonts.h] [BigFont.h]
+#
+# Each glyph fills a whole cell (12x16 source pixels times the scale) and is stored as one RLE
+# stream in the ILI9341's ROTATE180 window fill order: columns right to left, each column top to
+# bottom. Runs may cross column boundaries. One byte per run:
+#
+#   bit 7     1 = foreground, 0 = background
+#   bits 0-6  run length - 1 (1..128 pixels)
+#
+# For the other orientation the renderer just reads the stream backwards.
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from fontgen import load_font, FIRST_CHAR
+
+# Characters used by the scale 2 readouts ('~' is the degree sign), and the startup title
+BIG_CHARS = " 0123456789.-VAWkMCF%~<>"
+TITLE_CHARS = "FZR250"
+
+
+def pixel(img, r, c):
+	if 0 <= r < len(img) and 0 <= c < len(img[0]):
+		return img[r][c]
+	return 0
+
+
+def scale2x(img):
+	out = [[0] * (len(img[0]) * 2) for _ in range(len(img) * 2)]
+	for r in range(len(img)):
+		for c in range(len(img[0])):
+			A = pixel(img, r-1, c)
+			B = pixel(img, r, c+1)
+			C = pixel(img, r, c-1)
+			D = pixel(img, r+1, c)
+			P = img[r][c]
+			e0 = A if (C == A and C != D and A != B) else P
+			e1 = B if (A == B and A != C and B != D) else P
+			e2 = C if (D == C and D != B and C != A) else P
+			e3 = D if (B == D and B != A and D != C) else P
+			out[r*2][c*2], out[r*2][c*2+1] = e0, e1
+			out[r*2+1][c*2], out[r*2+1][c*2+1] = e2, e3
+	return out
+
+
+def scale3x(img):
+	out = [[0] * (len(img[0]) * 3) for _ in range(len(img) * 3)]
+	for r in range(len(img)):
+		for c in range(len(img[0])):
+			A = pixel(img, r-1, c-1); B = pixel(img, r-1, c); C = pixel(img, r-1, c+1)
+			D = pixel(img, r, c-1);   E = img[r][c];          F = pixel(img, r, c+1)
+			G = pixel(img, r+1, c-1); H = pixel(img, r+1, c); I = pixel(img, r+1, c+1)
+			if B != H and D != F:
+				e = [
+					D if D == B else E,
+					B if (D == B and E != C) or (B == F and E != A) else E,
+					F if B == F else E,
+					D if (D == B and E != G) or (D == H and E != A) else E,
+					E,
+					F if (B == F and E != I) or (H == F and E != C) else E,
+					D if D == H else E,
+					H if (D == H and E != I) or (H == F and E != G) else E,
+					F if H == F else E]
+			else:
+				e = [E] * 9
+			for i in range(9):
+				out[r*3 + i//3][c*3 + i%3] = e[i]
+	return out
+
+
+def encode_runs(img):
+	height = len(img)
+	width = len(img[0])
+	stream = [img[r][c] for c in range(width - 1, -1, -1) for r in range(height)]
+	runs = []
+	i = 0
+	while i < len(stream):
+		ink = stream[i]
+		n = 1
+		while i + n < len(stream) and stream[i + n] == ink and n < 128:
+			n += 1
+		runs.append((0x80 if ink else 0) | (n - 1))
+		i += n
+	return runs
+
+
+def emit_font(out, prefix, chars, glyphs, scaler, scale):
+	index = []
+	runs = []
+	for ch in chars:
+		index.append(len(runs))
+		runs.extend(encode_runs(scaler(glyphs[ord(ch) - FIRST_CHAR])))
+	index.append(len(runs))
+
+	out.append("#define %s_WIDTH\t\t%d" % (prefix, 12 * scale))
+	out.append("#define %s_HEIGHT\t%d" % (prefix, 16 * scale))
+	out.append("")
+	out.append("const char %s_CHARS[] PROGMEM = \"%s\";" % (prefix, chars))
+	out.append("")
+	out.append("// Offset of each glyph's runs in %s_RUNS, plus one past the end" % prefix)
+	out.append("const unsigned short %s_INDEX[%d] PROGMEM = {" % (prefix, len(index)))
+	out.append("\t" + ",".join("%d" % i for i in index))
+	out.append("};")
+	out.append("")
+	out.append("const unsigned char %s_RUNS[%d] PROGMEM = {" % (prefix, len(runs)))
+	for i in range(0, len(runs), 24):
+		chunk = runs[i:i+24]
+		comma = ',' if i + 24 < len(runs) else ''
+		out.append("\t" + ",".join("0x%02X" % b for b in chunk) + comma)
+	out.append("};")
+	out.append("")
+	return len(index) * 2 + len(runs) + len(chars) + 1
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, '..', 'Fonts.h')
+	dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, '..', 'BigFont.h')
+
+	glyphs = load_font(src)
+
+	out = []
+	out.append("// BigFont.h")
+	out.append("// Pre-rendered, run-length encoded large fonts used by TFT_LargeText()")
+	out.append("// GENERATED by tools/bigfontgen.py from Fonts.h - edit the generator or source font, not this file")
+	out.append("// Runs: bit 7 = foreground, bits 0-6 = length-1, columns right to left, each top to bottom")
+	out.append("")
+	out.append("// Scale 2 numerals and units, 24x32 cells (Scale2x)")
+	size = emit_font(out, "BIG_FONT", BIG_CHARS, glyphs, scale2x, 2)
+	out.append("// Scale 3 startup title, 36x48 cells (Scale3x)")
+	size += emit_font(out, "TITLE_FONT", TITLE_CHARS, glyphs, scale3x, 3)
+
+	with open(dst, 'w', newline='\r\n') as f:
+		f.write("\n".join(out))
+
+	print("Wrote %s: %d bytes" % (dst, size))
+
+
+if __name__ == '__main__':
+	main()
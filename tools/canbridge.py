@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+# canbridge.py
+# Host side of the Monitor's CAN to UART bridge (build with CAN_BRIDGE 1). Decodes the binary stream
+# from USART0 into a candump -l compatible log, and can inject frames from a candump log the other way.
+#
+# Usage: python3 tools/canbridge.py <serial port or pty> [log file] [--inject candump.log] [--iface can0]
+#
+# The log goes to stdout if no file is given. Drop counters from the Monitor's heartbeat are reported
+# on stderr whenever they change. Each record, in both directions, is
+#
+#   0xA5, kind << 4 | length, ID (2 bytes standard, 4 extended, none for heartbeats), timestamp (2),
+#   data (length bytes), checksum (XOR of everything after the 0xA5)
+#
+# all big endian. Kinds are 0 = standard frame, 1 = extended frame, 2 = heartbeat (data is the TX drop,
+# injected drop and bad record counters, 2 bytes each). Timestamps are 8us ticks of the CAN timer,
+# which wraps every 0.52s; the 4Hz heartbeats make sure we see every wrap.
+
+import os
+import sys
+import termios
+import threading
+import time
+import tty
+
+SYNC = 0xA5
+STD_FRAME, EXT_FRAME, HEARTBEAT = 0, 1, 2
+TICK = 8e-6
+BAUD = 1000000
+
+
+def open_port(path):
+	fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+	if os.isatty(fd):
+		tty.setraw(fd)
+		attrs = termios.tcgetattr(fd)
+		speed = getattr(termios, 'B%d' % BAUD, None)
+		if speed is not None: # A pty doesn't care, a real port does
+			attrs[4] = attrs[5] = speed
+			termios.tcsetattr(fd, termios.TCSANOW, attrs)
+	return fd
+
+
+def encode(kind, ident, data):
+	body = [kind << 4 | len(data)]
+	idBytes = {STD_FRAME: 2, EXT_FRAME: 4}.get(kind, 0)
+	body += [(ident >> (8 * n)) & 0xFF for n in range(idBytes - 1, -1, -1)]
+	body += [0, 0] # Timestamp, ignored by the Monitor
+	body += list(data)
+	checksum = 0
+	for b in body:
+		checksum ^= b
+	return bytes([SYNC] + body + [checksum])
+
+
+class Decoder:
+	def __init__(self):
+		self.buf = bytearray()
+		self.lastStamp = None
+		self.lastHost = None
+		self.ticks = 0
+		self.start = None
+		self.badRecords = 0
+
+	def feed(self, chunk):
+		self.buf += chunk
+		records = []
+		while True:
+			start = self.buf.find(SYNC)
+			if start < 0:
+				self.buf.clear()
+				return records
+			del self.buf[:start]
+			if len(self.buf) < 2:
+				return records
+
+			kind, length = self.buf[1] >> 4, self.buf[1] & 0x0F
+			idBytes = {STD_FRAME: 2, EXT_FRAME: 4, HEARTBEAT: 0}.get(kind)
+			if idBytes is None or (kind != HEARTBEAT and length > 8):
+				self.badRecords += 1
+				del self.buf[:1] # Wasn't really a sync byte
+				continue
+
+			size = 5 + idBytes + length
+			if len(self.buf) < size:
+				return records
+			record = self.buf[:size]
+			checksum = 0
+			for b in record[1:-1]:
+				checksum ^= b
+			if checksum != record[-1]:
+				self.badRecords += 1
+				del self.buf[:1]
+				continue
+			del self.buf[:size]
+
+			ident = int.from_bytes(record[2:2 + idBytes], 'big')
+			stamp = int.from_bytes(record[2 + idBytes:4 + idBytes], 'big')
+			data = bytes(record[4 + idBytes:-1])
+			records.append((kind, ident, self.timestamp(stamp), data))
+
+	# Unwraps the 16-bit tick count. Records aren't quite in timestamp order (heartbeats are queued from
+	# the main loop, frames from the RX poll), so small steps backwards are allowed. After a long gap,
+	# the host's own clock decides how many times the timer wrapped.
+	def timestamp(self, stamp):
+		now = time.time()
+		if self.lastStamp is None:
+			self.start = now
+		else:
+			delta = (stamp - self.lastStamp) & 0xFFFF
+			if delta >= 0x8000:
+				delta -= 0x10000
+			expected = (now - self.lastHost) / TICK
+			if expected > 0x8000:
+				delta += round((expected - delta) / 0x10000) * 0x10000
+			self.ticks += delta
+		self.lastStamp = stamp
+		self.lastHost = now
+		return self.start + self.ticks * TICK
+
+
+def candump_line(iface, kind, ident, stamp, data):
+	idText = "%08X" % ident if kind == EXT_FRAME else "%03X" % ident
+	return "(%.6f) %s %s#%s\n" % (stamp, iface, idText, data.hex().upper())
+
+
+def parse_candump(line):
+	# "(1234.567890) can0 18FF50E5#0102" -> (seconds, kind, ident, data)
+	parts = line.split()
+	if len(parts) < 3 or '#' not in parts[2]:
+		return None
+	idText, dataText = parts[2].split('#', 1)
+	kind = EXT_FRAME if len(idText) > 3 else STD_FRAME
+	return float(parts[0].strip('()')), kind, int(idText, 16), bytes.fromhex(dataText)
+
+
+def inject(fd, path):
+	lastStamp = None
+	for line in open(path):
+		frame = parse_candump(line)
+		if frame is None:
+			continue
+		stamp, kind, ident, data = frame
+		if lastStamp is not None:
+			time.sleep(min(max(stamp - lastStamp, 0), 1.0)) # Keep the original pacing, within reason
+		lastStamp = stamp
+		os.write(fd, encode(kind, ident, data))
+
+
+def main():
+	args = sys.argv[1:]
+	iface = 'can0'
+	injectPath = None
+	if '--iface' in args:
+		i = args.index('--iface')
+		iface = args[i + 1]
+		del args[i:i + 2]
+	if '--inject' in args:
+		i = args.index('--inject')
+		injectPath = args[i + 1]
+		del args[i:i + 2]
+	if not args:
+		sys.exit("Usage: canbridge.py <serial port> [log file] [--inject candump.log] [--iface can0]")
+
+	fd = open_port(args[0])
+	out = open(args[1], 'w') if len(args) > 1 else sys.stdout
+	if injectPath:
+		threading.Thread(target=inject, args=(fd, injectPath), daemon=True).start()
+
+	decoder = Decoder()
+	counters = None
+	try:
+		while True:
+			chunk = os.read(fd, 4096)
+			if not chunk:
+				break
+			for kind, ident, stamp, data in decoder.feed(chunk):
+				if kind == HEARTBEAT:
+					if len(data) >= 6 and data[:6] != counters:
+						counters = data[:6]
+						sys.stderr.write("Monitor drops: %d TX, %d injected, %d bad records (%d bad here)\n" % (
+							int.from_bytes(data[0:2], 'big'), int.from_bytes(data[2:4], 'big'),
+							int.from_bytes(data[4:6], 'big'), decoder.badRecords))
+				else:
+					out.write(candump_line(iface, kind, ident, stamp, data))
+			out.flush()
+	except KeyboardInterrupt:
+		pass
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# fontgen.py
+# Offline generator for the compressed proportional font used by TFT_PropText().
+# Reads FONT_16x16 from Fonts.h, crops every glyph to its ink bounding box and writes PropFont.h
+#
+# Usage: python3 tools/fontgen.py [Fonts.h] [PropFont.h]
+#
+# Only columns 2-13 of each 16x16 cell are ever shown by TFT_Char, so that's all we take from the
+# source bitmaps. Each glyph is stored as a bit-packed, column-major bitmap of just its ink box
+# (left to right, top to bottom, MSB first, each glyph starting on a byte boundary), plus a 5-byte
+# metrics entry:
+#
+#   [0..1] byte offset of the glyph bitmap in PROP_FONT_BITS (little endian)
+#   [2]    top row << 4 | (rows - 1)
+#   [3]    ink columns << 4 | left bearing
+#   [4]    advance width in pixels
+#
+# Digits are given a common advance (tabular figures) so numbers still line up and overwrite cleanly.
+
+import os
+import re
+import sys
+
+FIRST_CHAR = 32
+NUM_CHARS = 95
+CELL_ROWS = 16
+SHOWN_COLS = range(2, 14)	# columns TFT_Char actually renders
+SPACING = 2					# blank pixels between glyphs (1 each side)
+SPACE_ADVANCE = 5
+
+
+def load_font(path):
+	text = open(path).read()
+	body = text.split('{', 1)[1]
+	data = [int(x, 16) for x in re.findall(r'0x([0-9A-Fa-f]{2})', body)]
+	if len(data) != NUM_CHARS * 32:
+		sys.exit("Expected %d bytes in FONT_16x16, found %d" % (NUM_CHARS * 32, len(data)))
+
+	glyphs = []
+	for g in range(NUM_CHARS):
+		rows = []
+		for r in range(CELL_ROWS):
+			word = (data[g*32 + r*2] << 8) | data[g*32 + r*2 + 1]
+			rows.append([(word >> (15 - c)) & 1 for c in SHOWN_COLS])
+		glyphs.append(rows)
+	return glyphs
+
+
+def crop(rows):
+	ink = [(r, c) for r, row in enumerate(rows) for c, bit in enumerate(row) if bit]
+	if not ink:
+		return None
+	top = min(r for r, c in ink)
+	bottom = max(r for r, c in ink)
+	left = min(c for r, c in ink)
+	right = max(c for r, c in ink)
+	return top, bottom - top + 1, left, right - left + 1
+
+
+def pack_columns(rows, box):
+	top, height, left, width = box
+	bits = []
+	for c in range(left, left + width):
+		for r in range(top, top + height):
+			bits.append(rows[r][c])
+	while len(bits) % 8:
+		bits.append(0)
+	return [int(''.join(str(b) for b in bits[i:i+8]), 2) for i in range(0, len(bits), 8)]
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, '..', 'Fonts.h')
+	dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, '..', 'PropFont.h')
+
+	glyphs = load_font(src)
+	boxes = [crop(rows) for rows in glyphs]
+
+	digitAdvance = max(boxes[ord(d) - FIRST_CHAR][3] for d in '0123456789') + SPACING
+
+	metrics = []
+	bitmap = []
+	for g, rows in enumerate(glyphs):
+		ch = chr(FIRST_CHAR + g)
+		box = boxes[g]
+		if box is None:
+			metrics.append((len(bitmap), 0, 0, 0, 0, SPACE_ADVANCE, ch))
+			continue
+
+		top, height, left, width = box
+		if ch.isdigit():
+			advance = digitAdvance
+			bearing = (advance - width) // 2
+		else:
+			advance = width + SPACING
+			bearing = SPACING // 2
+
+		metrics.append((len(bitmap), top, height, width, bearing, advance, ch))
+		bitmap.extend(pack_columns(rows, box))
+
+	if len(bitmap) > 0xFFFF:
+		sys.exit("Bitmap too large for 16-bit offsets")
+
+	out = []
+	out.append("// PropFont.h")
+	out.append("// Cropped, bit-packed proportional version of FONT_16x16, used by TFT_PropText()")
+	out.append("// GENERATED by tools/fontgen.py from Fonts.h - edit the generator or source font, not this file")
+	out.append("// %d bytes of metrics + %d bytes of bitmaps (FONT_16x16 is %d bytes)"
+		% (len(metrics) * 5, len(bitmap), NUM_CHARS * 32))
+	out.append("")
+	out.append("#define PROP_FONT_FIRST\t\t%d" % FIRST_CHAR)
+	out.append("#define PROP_FONT_COUNT\t\t%d" % NUM_CHARS)
+	out.append("#define PROP_FONT_HEIGHT\t%d" % CELL_ROWS)
+	out.append("")
+	out.append("// Per glyph: offset lo, offset hi, top<<4 | (rows-1), cols<<4 | left bearing, advance")
+	out.append("const unsigned char PROP_FONT_METRICS[%d][5] PROGMEM = {" % NUM_CHARS)
+	for i, (offset, top, height, width, bearing, advance, ch) in enumerate(metrics):
+		name = {' ': '<Space>', '\\': '<Backslash>', '~': '~ (degrees sign)'}.get(ch, ch)
+		rowsField = (top << 4) | (height - 1) if height else 0
+		comma = ',' if i < len(metrics) - 1 else ' '
+		out.append("\t{ 0x%02X,0x%02X, 0x%02X, 0x%02X, %2d }%s // %s"
+			% (offset & 0xFF, offset >> 8, rowsField, (width << 4) | bearing, advance, comma, name))
+	out.append("};")
+	out.append("")
+	out.append("const unsigned char PROP_FONT_BITS[%d] PROGMEM = {" % len(bitmap))
+	for i in range(0, len(bitmap), 24):
+		chunk = bitmap[i:i+24]
+		comma = ',' if i + 24 < len(bitmap) else ''
+		out.append("\t" + ",".join("0x%02X" % b for b in chunk) + comma)
+	out.append("};")
+	out.append("")
+
+	with open(dst, 'w', newline='\r\n') as f:
+		f.write("\n".join(out))
+
+	print("Wrote %s: %d glyphs, %d bytes total (was %d)"
+		% (dst, NUM_CHARS, len(metrics) * 5 + len(bitmap), NUM_CHARS * 32))
+
+
+if __name__ == '__main__':
+	main()
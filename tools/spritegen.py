@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# spritegen.py
+# Offline generator for the palette-indexed RLE sprites drawn by TFT_Sprite().
+# Reads every PNG in tools/icons and writes Sprites.h
+#
+# Usage: python3 tools/spritegen.py [icon directory] [Sprites.h]
+#
+# Images may use up to 16 colours. Indexed PNGs keep their palette order (so palette entries can be
+# overridden at run time by index), truecolour PNGs get their colours in first-seen order.
+# Each sprite is one PROGMEM byte array:
+#
+#   [0] width  [1] height  [2] bits per index (2 or 4)  [3] palette entries
+#   [4..5] number of runs (little endian)
+#   palette, 2 bytes per entry (RGB565, little endian)
+#   runs, one byte each: index << (8 - bpp) | (length - 1)
+#
+# Pixels are run-length encoded in the ILI9341's ROTATE180 window fill order (columns right to left,
+# each column top to bottom), the same as BigFont.h, so the other orientation reads the runs backwards.
+# Runs never need more than one byte, which is what makes reading them backwards possible.
+
+import os
+import struct
+import sys
+import zlib
+
+
+def paeth(a, b, c):
+	p = a + b - c
+	pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+	if pa <= pb and pa <= pc:
+		return a
+	return b if pb <= pc else c
+
+
+def read_png(path):
+	data = open(path, 'rb').read()
+	if data[:8] != b'\x89PNG\r\n\x1a\n':
+		sys.exit("%s is not a PNG" % path)
+
+	pos = 8
+	idat = b''
+	palette = None
+	while pos < len(data):
+		length, kind = struct.unpack('>I4s', data[pos:pos+8])
+		body = data[pos+8:pos+8+length]
+		pos += 12 + length
+		if kind == b'IHDR':
+			width, height, depth, colourType, _, _, interlace = struct.unpack('>IIBBBBB', body)
+		elif kind == b'PLTE':
+			palette = [tuple(body[i:i+3]) for i in range(0, len(body), 3)]
+		elif kind == b'IDAT':
+			idat += body
+		elif kind == b'IEND':
+			break
+
+	if interlace:
+		sys.exit("%s: interlaced PNGs aren't supported" % path)
+	channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[colourType]
+	if depth != 8 and colourType != 3:
+		sys.exit("%s: only 8 bit truecolour/greyscale PNGs are supported" % path)
+
+	bitsPerPixel = depth * channels
+	stride = (width * bitsPerPixel + 7) // 8
+	step = max(1, bitsPerPixel // 8)
+	raw = zlib.decompress(idat)
+
+	rows = []
+	prev = bytearray(stride)
+	for y in range(height):
+		filt = raw[y * (stride + 1)]
+		line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+		for i in range(stride):
+			a = line[i - step] if i >= step else 0
+			b = prev[i]
+			c = prev[i - step] if i >= step else 0
+			if filt == 1: line[i] = (line[i] + a) & 0xFF
+			elif filt == 2: line[i] = (line[i] + b) & 0xFF
+			elif filt == 3: line[i] = (line[i] + (a + b) // 2) & 0xFF
+			elif filt == 4: line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+		prev = line
+
+		if colourType == 3:
+			perByte = 8 // depth
+			rows.append([(line[x // perByte] >> (8 - depth * (x % perByte + 1))) & ((1 << depth) - 1)
+				for x in range(width)])
+		else:
+			pixels = [tuple(line[x*channels:(x+1)*channels]) for x in range(width)]
+			if colourType in (0, 4):
+				pixels = [(p[0], p[0], p[0]) for p in pixels]
+			rows.append([p[:3] for p in pixels])
+
+	if colourType == 3:
+		used = max(max(r) for r in rows) + 1
+		return rows, palette[:used]
+
+	colours = []
+	for r in rows:
+		for p in r:
+			if p not in colours:
+				colours.append(p)
+	return [[colours.index(p) for p in r] for r in rows], colours
+
+
+def rgb565(c):
+	return ((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3)
+
+
+def encode(rows, bpp):
+	maxRun = 1 << (8 - bpp)
+	width = len(rows[0])
+	stream = [rows[r][c] for c in range(width - 1, -1, -1) for r in range(len(rows))]
+	runs = []
+	i = 0
+	while i < len(stream):
+		n = 1
+		while i + n < len(stream) and stream[i + n] == stream[i] and n < maxRun:
+			n += 1
+		runs.append((stream[i] << (8 - bpp)) | (n - 1))
+		i += n
+	return runs
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, 'icons')
+	dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, '..', 'Sprites.h')
+
+	out = []
+	out.append("// Sprites.h")
+	out.append("// Palette-indexed, run-length encoded sprites for TFT_Sprite()")
+	out.append("// GENERATED by tools/spritegen.py from tools/icons/*.png - edit the images, not this file")
+	out.append("// Layout: width, height, bpp, palette entries, run count (2 bytes), RGB565 palette, runs")
+	out.append("")
+
+	total = 0
+	for name in sorted(os.listdir(src)):
+		if not name.lower().endswith('.png'):
+			continue
+		rows, palette = read_png(os.path.join(src, name))
+		if len(palette) > 16:
+			sys.exit("%s has %d colours, 16 is the limit" % (name, len(palette)))
+		width, height = len(rows[0]), len(rows)
+		if width > 255 or height > 255:
+			sys.exit("%s is bigger than 255x255" % name)
+
+		bpp = 2 if len(palette) <= 4 else 4
+		runs = encode(rows, bpp)
+		body = [width, height, bpp, len(palette), len(runs) & 0xFF, len(runs) >> 8]
+		for c in palette:
+			body += [rgb565(c) & 0xFF, rgb565(c) >> 8]
+		body += runs
+		total += len(body)
+
+		ident = "SPRITE_" + os.path.splitext(name)[0].upper()
+		out.append("// %s: %dx%d, %d colours, %d runs" % (name, width, height, len(palette), len(runs)))
+		out.append("const unsigned char %s[%d] PROGMEM = {" % (ident, len(body)))
+		for i in range(0, len(body), 24):
+			chunk = body[i:i+24]
+			comma = ',' if i + 24 < len(body) else ''
+			out.append("\t" + ",".join("0x%02X" % b for b in chunk) + comma)
+		out.append("};")
+		out.append("")
+
+	with open(dst, 'w', newline='\r\n') as f:
+		f.write("\n".join(out))
+
+	print("Wrote %s: %d bytes" % (dst, total))
+
+
+if __name__ == '__main__':
+	main()